@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace openapi::bench {
+
+// A benchmark operation, executed repeatedly by the harness.
+using op_t = std::function<void()>;
+
+// Prepares the input data and returns the operation to measure.
+// Only called if the benchmark is selected.
+using setup_t = std::function<op_t()>;
+
+struct result {
+  std::string name_;
+  std::uint64_t iterations_{0U};
+  double ns_per_op_{0.0};
+  double bytes_per_op_{0.0};
+  double allocs_per_op_{0.0};
+};
+
+std::vector<std::pair<std::string, setup_t>>& registry();
+
+inline void add(std::string name, setup_t setup) {
+  registry().emplace_back(std::move(name), std::move(setup));
+}
+
+// Runs fn during static initialization to register benchmarks.
+struct registrar {
+  explicit registrar(std::function<void()> const& fn) { fn(); }
+};
+
+template <typename T>
+inline void do_not_optimize(T const& x) {
+  asm volatile("" : : "g"(&x) : "memory");
+}
+
+}  // namespace openapi::bench
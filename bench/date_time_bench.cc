@@ -0,0 +1,54 @@
+#include <sstream>
+
+#include "fmt/ostream.h"
+
+#include "openapi/date_time.h"
+
+#include "bench.h"
+
+using namespace openapi::bench;
+
+namespace {
+
+auto const reg = registrar{[]() {
+  add("date_time/parse", []() -> op_t {
+    return []() {
+      auto t = openapi::date_time_t{};
+      openapi::parse("2024-06-01T08:30:00Z", t);
+      do_not_optimize(t);
+    };
+  });
+
+  add("date_time/parse_offset", []() -> op_t {
+    return []() {
+      auto t = openapi::date_time_t{};
+      openapi::parse("2024-06-01T08:30:00+02:00", t);
+      do_not_optimize(t);
+    };
+  });
+
+  add("date_time/format", []() -> op_t {
+    auto t = openapi::date_time_t{};
+    openapi::parse("2024-06-01T08:30:00Z", t);
+    return [t]() { do_not_optimize(fmt::to_string(fmt::streamed(t))); };
+  });
+
+  add("date/parse", []() -> op_t {
+    return []() {
+      auto d = openapi::date_t{};
+      openapi::parse("2024-06-01", d);
+      do_not_optimize(d);
+    };
+  });
+
+  add("date/format", []() -> op_t {
+    auto d = openapi::date_t{};
+    openapi::parse("2024-06-01", d);
+    return [d]() {
+      auto buf = openapi::date_buf_t{};
+      do_not_optimize(openapi::format(d, buf));
+    };
+  });
+}};
+
+}  // namespace
@@ -0,0 +1,43 @@
+#include "fmt/ostream.h"
+
+#include "boost/json.hpp"
+
+#include "openapi/json.h"
+
+#include "pet-api/pet-api.h"
+
+#include "bench.h"
+
+namespace json = boost::json;
+using namespace openapi::bench;
+using namespace pet;
+
+namespace {
+
+auto const reg = registrar{[]() {
+  add("enum/parse", []() -> op_t {
+    return []() {
+      auto x = StatusEnum{};
+      openapi::parse("OFF", x);
+      do_not_optimize(x);
+    };
+  });
+
+  add("enum/value_to", []() -> op_t {
+    return [jv = json::value{"OFF"}]() {
+      do_not_optimize(json::value_to<StatusEnum>(jv));
+    };
+  });
+
+  add("enum/value_from", []() -> op_t {
+    return []() { do_not_optimize(json::value_from(StatusEnum::OFF)); };
+  });
+
+  add("enum/format", []() -> op_t {
+    return []() {
+      do_not_optimize(fmt::to_string(fmt::streamed(StatusEnum::OFF)));
+    };
+  });
+}};
+
+}  // namespace
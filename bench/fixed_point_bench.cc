@@ -0,0 +1,91 @@
+#include <array>
+#include <charconv>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "openapi/fixed_point.h"
+
+#include "bench.h"
+
+using namespace openapi::bench;
+using openapi::fixed_point;
+
+namespace {
+
+constexpr auto const kN = 1'000U;
+
+std::vector<double> make_coordinates() {
+  auto rng = std::mt19937{42U};
+  auto dist = std::uniform_int_distribution<int>{-180'000'000, 180'000'000};
+  auto values = std::vector<double>(kN);
+  for (auto& x : values) {
+    x = dist(rng) / 1e6;
+  }
+  return values;
+}
+
+std::vector<std::string> to_strings(std::vector<double> const& values) {
+  auto strings = std::vector<std::string>{};
+  for (auto const x : values) {
+    strings.push_back(fmt::format("{}", x));
+  }
+  return strings;
+}
+
+auto const reg = registrar{[]() {
+  add("fixed_point/format/double/1000", []() -> op_t {
+    return [values = make_coordinates()]() {
+      auto buf = fmt::memory_buffer{};
+      for (auto const x : values) {
+        fmt::format_to(std::back_inserter(buf), "{}", x);
+      }
+      do_not_optimize(buf);
+    };
+  });
+
+  add("fixed_point/format/fixed_point/1000", []() -> op_t {
+    auto values = std::vector<fixed_point<6U>>{};
+    for (auto const x : make_coordinates()) {
+      values.emplace_back(x);
+    }
+    return [values = std::move(values)]() {
+      auto buf = fmt::memory_buffer{};
+      auto tmp = std::array<char, fixed_point<6U>::kMaxChars>{};
+      for (auto const x : values) {
+        auto const end = to_chars(tmp.data(), tmp.data() + tmp.size(), x).ptr;
+        buf.append(tmp.data(), end);
+      }
+      do_not_optimize(buf);
+    };
+  });
+
+  add("fixed_point/parse/double/1000", []() -> op_t {
+    return [strings = to_strings(make_coordinates())]() {
+      auto sum = 0.0;
+      for (auto const& s : strings) {
+        auto x = 0.0;
+        std::from_chars(s.data(), s.data() + s.size(), x);
+        sum += x;
+      }
+      do_not_optimize(sum);
+    };
+  });
+
+  add("fixed_point/parse/fixed_point/1000", []() -> op_t {
+    return [strings = to_strings(make_coordinates())]() {
+      auto sum = std::int64_t{0};
+      for (auto const& s : strings) {
+        auto x = fixed_point<6U>{};
+        from_chars(s.data(), s.data() + s.size(), x);
+        sum += x.value_;
+      }
+      do_not_optimize(sum);
+    };
+  });
+}};
+
+}  // namespace
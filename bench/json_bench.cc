@@ -0,0 +1,115 @@
+#include <string>
+#include <vector>
+
+#include "fmt/core.h"
+
+#include "boost/json.hpp"
+
+#include "openapi/json.h"
+
+#include "pet-api/pet-api.h"
+
+#include "bench.h"
+
+namespace json = boost::json;
+using namespace openapi::bench;
+using namespace pet;
+
+namespace {
+
+Item make_item(std::size_t const i) {
+  return Item{.x_ = i % 2U == 0U ? StatusEnum::ON : StatusEnum::OFF,
+              .y_ = Pets{PetsEnum::A, PetsEnum::B},
+              .z_ = static_cast<std::int64_t>(i)};
+}
+
+Vehicle make_vehicle(std::size_t const i) {
+  auto v = Vehicle{.id_ = fmt::format("vehicle-{}", i)};
+  v.set_bearing(static_cast<double>(i % 360U));
+  v.set_speed(13.5);
+  v.set_status(StatusEnum::ON);
+  v.set_counts(openapi::flat_map<std::int64_t>{{"boarding", 12},
+                                               {"alighting", 7}});
+  v.set_lastUpdate(openapi::date_time_t{std::chrono::sys_seconds{
+      std::chrono::seconds{1'700'000'000 + static_cast<long>(i)}}});
+  return v;
+}
+
+Trip make_trip(std::size_t const i) {
+  auto items = std::vector<Item>{};
+  for (auto j = 0U; j != 8U; ++j) {
+    items.push_back(make_item(j));
+  }
+  return Trip{.id_ = fmt::format("trip-{}", i),
+              .vehicle_ = make_vehicle(i),
+              .items_ = std::move(items)};
+}
+
+template <typename T, typename Make>
+void add_codec(std::string_view type, Make&& make) {
+  for (auto const n : {1U, 100U, 10'000U}) {
+    auto const make_values = [=]() {
+      auto values = std::vector<T>{};
+      values.reserve(n);
+      for (auto i = 0U; i != n; ++i) {
+        values.push_back(make(i));
+      }
+      return values;
+    };
+
+    add(fmt::format("json/encode/{}/{}", type, n), [=]() -> op_t {
+      return [values = make_values()]() {
+        do_not_optimize(json::serialize(json::value_from(values)));
+      };
+    });
+
+    add(fmt::format("json/serialize/{}/{}", type, n), [=]() -> op_t {
+      return [values = make_values()]() {
+        do_not_optimize(openapi::serialize(values));
+      };
+    });
+
+    add(fmt::format("json/decode/{}/{}", type, n), [=]() -> op_t {
+      return [s = json::serialize(json::value_from(make_values()))]() {
+        do_not_optimize(json::value_to<std::vector<T>>(json::parse(s)));
+      };
+    });
+  }
+}
+
+std::string large_vehicle() {
+  auto v = make_vehicle(0U);
+  auto counts = openapi::flat_map<std::int64_t>{};
+  for (auto i = 0U; i != 1'000U; ++i) {
+    counts[fmt::format("stop-{}", i)] = i;
+  }
+  v.set_counts(std::move(counts));
+  return json::serialize(json::value_from(v));
+}
+
+auto const reg = registrar{[]() {
+  add_codec<Item>("Item", make_item);
+  add_codec<Vehicle>("Vehicle", make_vehicle);
+  add_codec<Trip>("Trip", make_trip);
+
+  add("lazy/Vehicle/decode_full", []() -> op_t {
+    return [s = large_vehicle()]() {
+      do_not_optimize(json::value_to<Vehicle>(json::parse(s)));
+    };
+  });
+
+  add("lazy/Vehicle/sparse", []() -> op_t {
+    return [s = large_vehicle()]() {
+      auto const v = openapi::lazy<Vehicle>{s};
+      do_not_optimize(v.speed());
+    };
+  });
+
+  add("lazy/Vehicle/full", []() -> op_t {
+    return [s = large_vehicle()]() {
+      do_not_optimize(openapi::lazy<Vehicle>{s}.get());
+    };
+  });
+}};
+
+}  // namespace
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string_view>
+
+#include "fmt/core.h"
+
+#include "boost/json.hpp"
+
+#include "openapi/alloc_probe.h"
+
+#include "bench.h"
+
+namespace json = boost::json;
+
+namespace openapi::bench {
+
+std::vector<std::pair<std::string, setup_t>>& registry() {
+  static auto r = std::vector<std::pair<std::string, setup_t>>{};
+  return r;
+}
+
+result run(std::string const& name,
+           op_t const& op,
+           std::chrono::nanoseconds const min_time) {
+  using clock = std::chrono::steady_clock;
+
+  op();  // warm up
+
+  auto n = std::uint64_t{1U};
+  while (true) {
+    auto const probe = alloc_probe{};
+    auto const t0 = clock::now();
+    for (auto i = std::uint64_t{0U}; i != n; ++i) {
+      op();
+    }
+    auto const t = clock::now() - t0;
+    auto const allocs = probe.get();
+
+    if (t >= min_time || n >= 1'000'000'000U) {
+      auto const iterations = static_cast<double>(n);
+      return {.name_ = name,
+              .iterations_ = n,
+              .ns_per_op_ = static_cast<double>(t.count()) / iterations,
+              .bytes_per_op_ =
+                  static_cast<double>(allocs.bytes_) / iterations,
+              .allocs_per_op_ =
+                  static_cast<double>(allocs.count_) / iterations};
+    }
+
+    auto const elapsed = std::max(t, clock::duration{1});
+    auto const scale = static_cast<double>(min_time.count()) * 1.2 /
+                       static_cast<double>(elapsed.count());
+    n = static_cast<std::uint64_t>(static_cast<double>(n) *
+                                   std::clamp(scale, 2.0, 100.0));
+  }
+}
+
+}  // namespace openapi::bench
+
+int main(int argc, char** argv) {
+  using namespace openapi::bench;
+
+  auto filter = std::string_view{};
+  auto min_time = std::chrono::milliseconds{200};
+  auto json_output = false;
+  for (auto i = 1; i < argc; ++i) {
+    auto const arg = std::string_view{argv[i]};
+    if (arg == "--json") {
+      json_output = true;
+    } else if (arg.starts_with("--filter=")) {
+      filter = arg.substr(9U);
+    } else if (arg.starts_with("--min-time-ms=")) {
+      min_time = std::chrono::milliseconds{
+          std::stoi(std::string{arg.substr(14U)})};
+    } else {
+      std::cout << "usage: " << argv[0]
+                << " [--json] [--filter=SUBSTRING] [--min-time-ms=N]\n";
+      return arg == "--help" ? 0 : 1;
+    }
+  }
+
+  auto failed = false;
+  auto results = std::vector<result>{};
+  for (auto const& [name, setup] : registry()) {
+    if (name.find(filter) == std::string::npos) {
+      continue;
+    }
+    try {
+      results.push_back(run(name, setup(), min_time));
+    } catch (std::exception const& e) {
+      std::cerr << name << ": " << e.what() << "\n";
+      failed = true;
+      continue;
+    }
+    if (!json_output) {
+      auto const& r = results.back();
+      std::cout << fmt::format("{:<40} {:>12} {:>12.1f} ns/op {:>12.1f} B/op "
+                               "{:>8.2f} allocs/op\n",
+                               r.name_, r.iterations_, r.ns_per_op_,
+                               r.bytes_per_op_, r.allocs_per_op_);
+    }
+  }
+
+  if (json_output) {
+    auto out = json::object{};
+    auto& benchmarks = out["benchmarks"].emplace_array();
+    for (auto const& r : results) {
+      auto& o = benchmarks.emplace_back(json::object{}).as_object();
+      o["name"] = r.name_;
+      o["iterations"] = r.iterations_;
+      o["ns_per_op"] = r.ns_per_op_;
+      o["bytes_per_op"] = r.bytes_per_op_;
+      o["allocs_per_op"] = r.allocs_per_op_;
+    }
+    std::cout << json::serialize(out) << "\n";
+  }
+
+  return failed ? 1 : 0;
+}
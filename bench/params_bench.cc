@@ -0,0 +1,52 @@
+#include <string>
+
+#include "fmt/format.h"
+
+#include "boost/url/url_view.hpp"
+
+#include "bench-api/bench-api.h"
+
+#include "bench.h"
+
+using namespace openapi::bench;
+
+namespace {
+
+constexpr auto const kMinimal =
+    "/plan?fromPlace=52.52,13.40&toPlace=48.14,11.58";
+
+constexpr auto const kFull =
+    "/plan?fromPlace=52.52,13.40&toPlace=48.14,11.58"
+    "&time=2024-06-01T08:30:00Z&arriveBy=true&mode=WALK,BIKE,TRANSIT"
+    "&maxTransfers=3&searchWindow=3600&numItineraries=10"
+    "&pageCursor=EARLIER%7C1717230600";
+
+auto const reg = registrar{[]() {
+  for (auto const& [name, url] :
+       {std::pair{"minimal", kMinimal}, std::pair{"full", kFull}}) {
+    add(std::string{"params/parse/plan/"} + name, [url]() -> op_t {
+      return [url]() {
+        do_not_optimize(
+            bench_api::plan_params{boost::urls::url_view{url}.params()});
+      };
+    });
+
+    add(std::string{"params/to_url/plan/"} + name, [url]() -> op_t {
+      return [p = bench_api::plan_params{
+                  boost::urls::url_view{url}.params()}]() {
+        do_not_optimize(p.to_url("/plan"));
+      };
+    });
+
+    add(std::string{"params/write_url/plan/"} + name, [url]() -> op_t {
+      return [p = bench_api::plan_params{
+                  boost::urls::url_view{url}.params()}]() {
+        auto buf = fmt::memory_buffer{};
+        p.write_url(buf);
+        do_not_optimize(buf);
+      };
+    });
+  }
+}};
+
+}  // namespace
@@ -0,0 +1,80 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fmt/core.h"
+
+#include "boost/json.hpp"
+
+#include "openapi/json.h"
+#include "openapi/polyline.h"
+
+#include "bench.h"
+
+namespace json = boost::json;
+using namespace openapi::bench;
+
+namespace {
+
+// Random walk with GPS-like 1e-5 degree resolution.
+openapi::polyline<5U> make_shape(std::size_t const n) {
+  auto rng = std::mt19937{42U};
+  auto step = std::uniform_int_distribution<int>{-300, 300};
+  auto lat = 4'987'000;
+  auto lng = 865'000;
+  auto p = openapi::polyline<5U>{};
+  p.reserve(n);
+  for (auto i = 0U; i != n; ++i) {
+    lat += step(rng);
+    lng += step(rng);
+    p.data_.push_back(openapi::fixed_point<5U>::from_raw(lat));
+    p.data_.push_back(openapi::fixed_point<5U>::from_raw(lng));
+  }
+  return p;
+}
+
+// The same geometry as a plain JSON array of [lat, lng] pairs.
+std::vector<std::vector<double>> to_array(openapi::polyline<5U> const& p) {
+  auto v = std::vector<std::vector<double>>{};
+  for (auto i = 0U; i != p.size(); ++i) {
+    v.push_back({p[i][0].to_double(), p[i][1].to_double()});
+  }
+  return v;
+}
+
+auto const reg = registrar{[]() {
+  for (auto const n : {100U, 10'000U}) {
+    auto const shape = make_shape(n);
+    auto const array = json::serialize(json::value_from(to_array(shape)));
+    auto const encoded = json::serialize(json::value_from(shape));
+
+    // Payload sizes are part of the name to compare them across formats.
+    add(fmt::format("polyline/encode/json_array/{}/{}B", n, array.size()),
+        [=]() -> op_t {
+          return [v = to_array(shape)]() {
+            do_not_optimize(json::serialize(json::value_from(v)));
+          };
+        });
+    add(fmt::format("polyline/encode/polyline/{}/{}B", n, encoded.size()),
+        [=]() -> op_t {
+          return [=]() {
+            do_not_optimize(json::serialize(json::value_from(shape)));
+          };
+        });
+
+    add(fmt::format("polyline/decode/json_array/{}", n), [=]() -> op_t {
+      return [=]() {
+        do_not_optimize(json::value_to<std::vector<std::vector<double>>>(
+            json::parse(array)));
+      };
+    });
+    add(fmt::format("polyline/decode/polyline/{}", n), [=]() -> op_t {
+      return [=]() {
+        do_not_optimize(
+            json::value_to<openapi::polyline<5U>>(json::parse(encoded)));
+      };
+    });
+  }
+}};
+
+}  // namespace
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "openapi/router.h"
+
+#include "routes-api/routes-api.h"
+
+#include "bench.h"
+
+using namespace openapi::bench;
+using openapi::http_method;
+
+namespace {
+
+// Resources of bench/routes.yml, each with five operations on three paths.
+constexpr auto const kResources = std::array<std::string_view, 40U>{
+    "stops",       "routes",      "trips",       "agencies",    "vehicles",
+    "drivers",     "depots",      "shifts",      "blocks",      "fares",
+    "zones",       "transfers",   "calendars",   "holidays",    "alerts",
+    "stations",    "platforms",   "elevators",   "levels",      "pathways",
+    "shapes",      "frequencies", "feeds",       "operators",   "lines",
+    "networks",    "tickets",     "passes",      "riders",      "accounts",
+    "payments",    "refunds",     "invoices",    "reports",     "incidents",
+    "cameras",     "sensors",     "counters",    "parkings",    "bikes"};
+
+struct route {
+  http_method method_;
+  std::string template_;
+  std::string example_;
+};
+
+std::vector<route> get_routes() {
+  auto routes = std::vector<route>{};
+  for (auto const r : kResources) {
+    auto const base = "/api/v1/" + std::string{r};
+    routes.push_back({http_method::kGet, base, base});
+    routes.push_back({http_method::kPost, base, base});
+    routes.push_back({http_method::kGet, base + "/{id}", base + "/4711"});
+    routes.push_back({http_method::kDelete, base + "/{id}", base + "/4711"});
+    routes.push_back({http_method::kGet, base + "/{id}/events/{eventId}",
+                      base + "/4711/events/12"});
+  }
+  return routes;
+}
+
+// What a hand-written matcher does: literal paths are compared as a whole,
+// templates segment by segment.
+bool matches(std::string_view tmpl, std::string_view path) {
+  if (tmpl.find('{') == std::string_view::npos) {
+    return tmpl == path;
+  }
+  auto t = std::string_view{};
+  auto p = std::string_view{};
+  while (true) {
+    auto const more_t = openapi::next_segment(tmpl, t);
+    auto const more_p = openapi::next_segment(path, p);
+    if (!more_t || !more_p) {
+      return more_t == more_p;
+    }
+    if (t.starts_with('{') ? p.empty() : t != p) {
+      return false;
+    }
+  }
+}
+
+int match_linear(std::vector<route> const& routes,
+                 http_method const method,
+                 std::string_view path) {
+  for (auto i = 0U; i != routes.size(); ++i) {
+    if (routes[i].method_ == method && matches(routes[i].template_, path)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+// Requests hitting all routes in random order.
+std::vector<route> get_requests() {
+  auto requests = get_routes();
+  std::shuffle(begin(requests), end(requests), std::mt19937{42U});
+  return requests;
+}
+
+auto const reg = registrar{[]() {
+  add("router/trie/200", []() -> op_t {
+    return [requests = get_requests(), i = std::size_t{0U}]() mutable {
+      auto const& r = requests[i++ % requests.size()];
+      do_not_optimize(routes_api::match_route(r.method_, r.example_));
+    };
+  });
+
+  add("router/linear/200", []() -> op_t {
+    return [routes = get_routes(), requests = get_requests(),
+            i = std::size_t{0U}]() mutable {
+      auto const& r = requests[i++ % requests.size()];
+      do_not_optimize(match_linear(routes, r.method_, r.example_));
+    };
+  });
+}};
+
+}  // namespace
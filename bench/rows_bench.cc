@@ -0,0 +1,60 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "fmt/core.h"
+
+#include "boost/json.hpp"
+
+#include "openapi/json.h"
+#include "openapi/rows.h"
+
+#include "pet-api/pet-api.h"
+
+#include "bench.h"
+
+namespace json = boost::json;
+using namespace openapi::bench;
+using namespace pet;
+
+namespace {
+
+// Zone polygon with n vertices on a circle.
+std::string make_zone(std::size_t const n) {
+  auto s = std::string{R"({"polygon":[)"};
+  for (auto i = 0U; i != n; ++i) {
+    auto const a = 2.0 * 3.141592653589793 * i / static_cast<double>(n);
+    s += fmt::format("{}[{:.6f},{:.6f}]", i == 0U ? "" : ",",
+                     8.65 + 0.1 * std::cos(a), 49.87 + 0.1 * std::sin(a));
+  }
+  s += "]}";
+  return s;
+}
+
+// dom_* decode through the JSON DOM like value_to and the request
+// decoders, text_fixed_rows reads the rows from the text (x-lazy only).
+auto const reg = registrar{[]() {
+  for (auto const n : {100U, 10'000U}) {
+    add(fmt::format("rows/decode/dom_nested_vector/{}", n), [=]() -> op_t {
+      return [s = make_zone(n)]() {
+        auto const jv = json::parse(s);
+        do_not_optimize(json::value_to<std::vector<std::vector<double>>>(
+            jv.at("polygon")));
+      };
+    });
+
+    add(fmt::format("rows/decode/dom_fixed_rows/{}", n), [=]() -> op_t {
+      return [s = make_zone(n)]() {
+        do_not_optimize(json::value_to<Zone>(json::parse(s)));
+      };
+    });
+
+    add(fmt::format("rows/decode/text_fixed_rows/{}", n), [=]() -> op_t {
+      return [s = make_zone(n)]() {
+        do_not_optimize(ZoneLazy{s}.polygon());
+      };
+    });
+  }
+}};
+
+}  // namespace
@@ -0,0 +1,15 @@
+#include "openapi/trace.h"
+
+#include "bench.h"
+
+using namespace openapi::bench;
+
+namespace {
+
+auto const reg = registrar{[]() {
+  add("trace/span", []() -> op_t {
+    return []() { auto const s = openapi::trace::span{"bench"}; };
+  });
+}};
+
+}  // namespace
@@ -0,0 +1,95 @@
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "openapi/uuid.h"
+
+#include "bench.h"
+
+using namespace openapi::bench;
+using openapi::uuid;
+
+namespace {
+
+constexpr auto const kN = 1'000U;
+
+std::vector<uuid> make_ids() {
+  auto rng = std::mt19937{42U};
+  auto ids = std::vector<uuid>(kN);
+  for (auto& id : ids) {
+    for (auto& b : id.bytes_) {
+      b = static_cast<std::uint8_t>(rng());
+    }
+  }
+  return ids;
+}
+
+std::vector<std::string> to_strings(std::vector<uuid> const& ids) {
+  auto strings = std::vector<std::string>{};
+  auto buf = openapi::uuid_buf_t{};
+  for (auto const& id : ids) {
+    strings.emplace_back(format(id, buf));
+  }
+  return strings;
+}
+
+auto const reg = registrar{[]() {
+  add("uuid/parse/string/1000", []() -> op_t {
+    return [strings = to_strings(make_ids())]() {
+      auto ids = std::vector<std::string>{};
+      ids.reserve(strings.size());
+      for (auto const& s : strings) {
+        ids.emplace_back(s);
+      }
+      do_not_optimize(ids);
+    };
+  });
+
+  add("uuid/parse/uuid/1000", []() -> op_t {
+    return [strings = to_strings(make_ids())]() {
+      auto ids = std::vector<uuid>(strings.size());
+      for (auto i = 0U; i != strings.size(); ++i) {
+        parse(strings[i], ids[i]);
+      }
+      do_not_optimize(ids);
+    };
+  });
+
+  add("uuid/format/uuid/1000", []() -> op_t {
+    return [ids = make_ids()]() {
+      auto out = std::string{};
+      auto buf = openapi::uuid_buf_t{};
+      for (auto const& id : ids) {
+        out += format(id, buf);
+      }
+      do_not_optimize(out);
+    };
+  });
+
+  add("uuid/lookup/string/1000", []() -> op_t {
+    auto const strings = to_strings(make_ids());
+    return [set = std::unordered_set<std::string>{strings.begin(),
+                                                  strings.end()},
+            strings]() {
+      auto n = 0U;
+      for (auto const& s : strings) {
+        n += set.contains(s) ? 1U : 0U;
+      }
+      do_not_optimize(n);
+    };
+  });
+
+  add("uuid/lookup/uuid/1000", []() -> op_t {
+    auto const ids = make_ids();
+    return [set = std::unordered_set<uuid>{ids.begin(), ids.end()}, ids]() {
+      auto n = 0U;
+      for (auto const& id : ids) {
+        n += set.contains(id) ? 1U : 0U;
+      }
+      do_not_optimize(n);
+    };
+  });
+}};
+
+}  // namespace
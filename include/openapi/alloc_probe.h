@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace openapi {
+
+struct alloc_stats {
+  friend alloc_stats operator-(alloc_stats const& a, alloc_stats const& b) {
+    return {.count_ = a.count_ - b.count_, .bytes_ = a.bytes_ - b.bytes_};
+  }
+
+  bool operator==(alloc_stats const&) const = default;
+
+  std::uint64_t count_{0U};
+  std::uint64_t bytes_{0U};
+};
+
+// Heap allocations of the current thread. Only updated if the executable
+// links the operator new replacement of the openapi-alloc-probe library.
+inline thread_local alloc_stats thread_allocs{};
+
+// Counts the heap allocations of the current thread since construction.
+struct alloc_probe {
+  alloc_stats get() const { return thread_allocs - start_; }
+  std::uint64_t count() const { return get().count_; }
+  std::uint64_t bytes() const { return get().bytes_; }
+
+  alloc_stats start_{thread_allocs};
+};
+
+}  // namespace openapi
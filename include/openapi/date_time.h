@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <iosfwd>
+#include <optional>
+#include <string_view>
 
 namespace openapi {
 
@@ -34,6 +38,41 @@ extern std::optional<date_time_t> now_test;
 
 date_time_t now();
 
+using date_time_buf_t = std::array<char, 32U>;
+
+// ISO 8601 with seconds precision and Z or the UTC offset (+HH:MM).
+std::string_view format(date_time_t const&, date_time_buf_t&);
+
 void parse(std::string_view, date_time_t&);
 
-}  // namespace openapi
\ No newline at end of file
+// Calendar day (format: date) stored as days since 1970-01-01.
+struct calendar_date {
+  calendar_date() = default;
+
+  calendar_date(std::chrono::sys_days const d)
+      : days_{static_cast<std::int32_t>(d.time_since_epoch().count())} {}
+
+  calendar_date(std::chrono::year_month_day const d)
+      : calendar_date{std::chrono::sys_days{d}} {}
+
+  friend std::ostream& operator<<(std::ostream&, calendar_date const&);
+
+  operator std::chrono::sys_days() const {
+    return std::chrono::sys_days{std::chrono::days{days_}};
+  }
+
+  auto operator<=>(calendar_date const&) const = default;
+
+  std::int32_t days_{0};
+};
+
+using date_t = calendar_date;
+
+using date_buf_t = std::array<char, 16U>;
+
+// YYYY-MM-DD
+std::string_view format(date_t const&, date_buf_t&);
+
+void parse(std::string_view, date_t&);
+
+}  // namespace openapi
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <bitset>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+
+namespace openapi {
+
+// Set of the K values of a generated enum (enum arrays with uniqueItems or
+// x-enum-set). Iterates in declaration order.
+template <typename E, std::size_t K>
+struct enum_set {
+  struct iterator {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = E;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = E;
+
+    E operator*() const { return static_cast<E>(i_); }
+
+    iterator& operator++() {
+      i_ = set_->next(i_ + 1U);
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto const tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(iterator const& o) const { return i_ == o.i_; }
+
+    enum_set const* set_{nullptr};
+    std::size_t i_{K};
+  };
+
+  constexpr enum_set() = default;
+
+  enum_set(std::initializer_list<E> values) {
+    for (auto const e : values) {
+      insert(e);
+    }
+  }
+
+  bool contains(E const e) const { return bits_.test(index(e)); }
+  void insert(E const e) { bits_.set(index(e)); }
+  void erase(E const e) { bits_.reset(index(e)); }
+  void clear() { bits_.reset(); }
+
+  std::size_t size() const { return bits_.count(); }
+  bool empty() const { return bits_.none(); }
+
+  iterator begin() const { return {this, next(0U)}; }
+  iterator end() const { return {this, K}; }
+
+  bool operator==(enum_set const&) const = default;
+
+  // Total order for the comparison operators of generated structs.
+  std::strong_ordering operator<=>(enum_set const& o) const {
+    for (auto i = std::size_t{0U}; i != K; ++i) {
+      if (bits_.test(i) != o.bits_.test(i)) {
+        return bits_.test(i) ? std::strong_ordering::less
+                             : std::strong_ordering::greater;
+      }
+    }
+    return std::strong_ordering::equal;
+  }
+
+  std::size_t next(std::size_t i) const {
+    while (i != K && !bits_.test(i)) {
+      ++i;
+    }
+    return i;
+  }
+
+  static std::size_t index(E const e) { return static_cast<std::size_t>(e); }
+
+  std::bitset<K> bits_;
+};
+
+}  // namespace openapi
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+namespace openapi {
+
+// Mask of the members of a nested object selected in a generated XFields.
+// Held by pointer so recursive schemas (a Node with Node children) get a
+// finite mask type. No mask means the whole object is selected.
+template <typename Fields>
+struct nested_fields {
+  nested_fields() = default;
+
+  nested_fields(nested_fields const& o)
+      : f_{o.f_ == nullptr ? nullptr : std::make_unique<Fields>(*o.f_)} {}
+
+  nested_fields(nested_fields&&) noexcept = default;
+
+  nested_fields& operator=(nested_fields const& o) {
+    if (this != &o) {
+      f_ = o.f_ == nullptr ? nullptr : std::make_unique<Fields>(*o.f_);
+    }
+    return *this;
+  }
+
+  nested_fields& operator=(nested_fields&&) noexcept = default;
+
+  ~nested_fields() = default;
+
+  bool operator==(nested_fields const& o) const {
+    return f_ == nullptr ? o.f_ == nullptr : o.f_ != nullptr && *f_ == *o.f_;
+  }
+
+  bool all() const { return f_ == nullptr; }
+
+  Fields const& operator*() const { return *f_; }
+
+  // Selects path below the object or, if it is empty, the whole object.
+  // Selected tells whether the object was selected before.
+  void add(std::string_view const path, bool const selected) {
+    if (path.empty()) {
+      f_.reset();
+    } else if (!selected) {
+      f_ = std::make_unique<Fields>();
+      f_->add(path);
+    } else if (f_ != nullptr) {
+      f_->add(path);
+    }
+  }
+
+  std::unique_ptr<Fields> f_;
+};
+
+}  // namespace openapi
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+
+namespace openapi {
+
+constexpr std::uint64_t decimal_scale(unsigned const digits) {
+  return digits == 0U ? 1U : 10U * decimal_scale(digits - 1U);
+}
+
+// Decimal number with Precision fraction digits, stored as an integer
+// scaled by 10^Precision. Used for numbers with x-precision.
+template <unsigned Precision>
+struct fixed_point {
+  static_assert(Precision <= 9U);
+
+  using rep_t = std::int32_t;
+  static constexpr auto const kScale =
+      static_cast<std::int64_t>(decimal_scale(Precision));
+
+  // Sign, integer digits, '.' and fraction digits.
+  static constexpr auto const kMaxChars = 12U + Precision;
+
+  constexpr fixed_point() = default;
+
+  // Rounds half away from zero.
+  constexpr fixed_point(double const x) {
+    auto const scaled = x * static_cast<double>(kScale);
+    if (!(scaled > std::numeric_limits<rep_t>::min() - 0.5 &&
+          scaled < std::numeric_limits<rep_t>::max() + 0.5)) {
+      throw std::out_of_range{"fixed_point: value out of range"};
+    }
+    value_ = static_cast<rep_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+  }
+
+  static constexpr fixed_point from_raw(rep_t const value) {
+    auto x = fixed_point{};
+    x.value_ = value;
+    return x;
+  }
+
+  constexpr double to_double() const {
+    return static_cast<double>(value_) / static_cast<double>(kScale);
+  }
+
+  auto operator<=>(fixed_point const&) const = default;
+
+  rep_t value_{0};
+};
+
+// Parses a JSON number without going through double: the decimal digits
+// are accumulated as an integer and rescaled to Precision fraction digits,
+// rounding half away from zero.
+template <unsigned Precision>
+std::from_chars_result from_chars(char const* const first,
+                                  char const* const last,
+                                  fixed_point<Precision>& x) {
+  constexpr auto const kMaxMantissa = std::uint64_t{100'000'000'000'000'000U};
+
+  auto p = first;
+  auto const negative = p != last && *p == '-';
+  if (negative) {
+    ++p;
+  }
+
+  auto mantissa = std::uint64_t{0U};
+  auto exponent = 0;
+  auto n_digits = 0U;
+  auto const is_digit = [&]() { return p != last && *p >= '0' && *p <= '9'; };
+  auto const add_digit = [&](bool const fraction) {
+    // Digits beyond 18 significant ones cannot change the int32 result.
+    if (mantissa < kMaxMantissa) {
+      mantissa = mantissa * 10U + static_cast<std::uint64_t>(*p - '0');
+      exponent -= fraction ? 1 : 0;
+    } else {
+      exponent += fraction ? 0 : 1;
+    }
+    ++n_digits;
+    ++p;
+  };
+
+  while (is_digit()) {
+    add_digit(false);
+  }
+  if (p != last && *p == '.') {
+    ++p;
+    while (is_digit()) {
+      add_digit(true);
+    }
+  }
+  if (n_digits == 0U) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  if (p != last && (*p == 'e' || *p == 'E')) {
+    ++p;
+    if (p != last && *p == '+') {
+      ++p;
+    }
+    auto e = 0;
+    auto const [ptr, ec] = std::from_chars(p, last, e);
+    if (ec != std::errc{}) {
+      return {first, std::errc::invalid_argument};
+    }
+    p = ptr;
+    exponent += std::clamp(e, -1000, 1000);
+  }
+
+  auto const shift = exponent + static_cast<int>(Precision);
+  auto value = std::uint64_t{0U};
+  if (mantissa == 0U) {
+    value = 0U;
+  } else if (shift >= 0) {
+    if (shift > 10) {
+      return {p, std::errc::result_out_of_range};
+    }
+    value = mantissa * decimal_scale(static_cast<unsigned>(shift));
+    if (value / decimal_scale(static_cast<unsigned>(shift)) != mantissa) {
+      return {p, std::errc::result_out_of_range};
+    }
+  } else if (shift >= -19) {
+    auto const d = decimal_scale(static_cast<unsigned>(-shift));
+    value = mantissa / d + (mantissa % d >= d / 2U ? 1U : 0U);
+  }
+
+  auto const max = static_cast<std::uint64_t>(
+                       std::numeric_limits<std::int32_t>::max()) +
+                   (negative ? 1U : 0U);
+  if (value > max) {
+    return {p, std::errc::result_out_of_range};
+  }
+  auto const signed_value = static_cast<std::int64_t>(value);
+  x.value_ = static_cast<std::int32_t>(negative ? -signed_value : signed_value);
+  return {p, std::errc{}};
+}
+
+// Shortest decimal form: trailing zeros of the fraction are dropped.
+template <unsigned Precision>
+std::to_chars_result to_chars(char* first,
+                              char* const last,
+                              fixed_point<Precision> const x) {
+  using fp = fixed_point<Precision>;
+  if (last - first < static_cast<std::ptrdiff_t>(fp::kMaxChars)) {
+    return {last, std::errc::value_too_large};
+  }
+
+  auto v = static_cast<std::int64_t>(x.value_);
+  if (v < 0) {
+    *first++ = '-';
+    v = -v;
+  }
+  first = std::to_chars(first, last, v / fp::kScale).ptr;
+
+  auto fraction = static_cast<std::uint64_t>(v % fp::kScale);
+  if (fraction != 0U) {
+    auto digits = std::array<char, Precision + 1U>{};
+    for (auto i = Precision; i != 0U; --i) {
+      digits[i - 1U] = static_cast<char>('0' + fraction % 10U);
+      fraction /= 10U;
+    }
+    auto n = Precision;
+    while (digits[n - 1U] == '0') {
+      --n;
+    }
+    *first++ = '.';
+    first = std::copy_n(digits.data(), n, first);
+  }
+  return {first, std::errc{}};
+}
+
+}  // namespace openapi
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace openapi {
+
+// Sorted vector map used for additionalProperties schemas.
+// Entries are kept contiguous and ordered by key.
+template <typename V>
+struct flat_map {
+  using key_type = std::string;
+  using mapped_type = V;
+  using value_type = std::pair<std::string, V>;
+  using container_t = std::vector<value_type>;
+  using iterator = typename container_t::iterator;
+  using const_iterator = typename container_t::const_iterator;
+
+  flat_map() = default;
+
+  explicit flat_map(container_t entries) : entries_{std::move(entries)} {
+    normalize();
+  }
+
+  flat_map(std::initializer_list<value_type> init) : entries_{init} {
+    normalize();
+  }
+
+  iterator find(std::string_view key) {
+    auto const it = lower_bound(key);
+    return it != end() && it->first == key ? it : end();
+  }
+
+  const_iterator find(std::string_view key) const {
+    auto const it = lower_bound(key);
+    return it != end() && it->first == key ? it : end();
+  }
+
+  bool contains(std::string_view key) const { return find(key) != end(); }
+
+  V& operator[](std::string_view key) {
+    auto const it = lower_bound(key);
+    if (it != end() && it->first == key) {
+      return it->second;
+    }
+    return entries_.emplace(it, std::string{key}, V{})->second;
+  }
+
+  std::pair<iterator, bool> emplace(std::string key, V value) {
+    auto const it = lower_bound(key);
+    if (it != end() && it->first == key) {
+      return {it, false};
+    }
+    return {entries_.emplace(it, std::move(key), std::move(value)), true};
+  }
+
+  std::size_t erase(std::string_view key) {
+    auto const it = find(key);
+    if (it == end()) {
+      return 0U;
+    }
+    entries_.erase(it);
+    return 1U;
+  }
+
+  void reserve(std::size_t const n) { entries_.reserve(n); }
+  void clear() { entries_.clear(); }
+  std::size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  auto operator<=>(flat_map const&) const = default;
+
+  iterator lower_bound(std::string_view key) {
+    return std::ranges::lower_bound(entries_, key, std::less<>{},
+                                    &value_type::first);
+  }
+
+  const_iterator lower_bound(std::string_view key) const {
+    return std::ranges::lower_bound(entries_, key, std::less<>{},
+                                    &value_type::first);
+  }
+
+  // Sorts bulk-inserted entries once. For duplicate keys the last one wins.
+  // Input that is already sorted (e.g. our own JSON output) skips the sort
+  // and its temporary buffer.
+  void normalize() {
+    if (!std::ranges::is_sorted(entries_, std::less<>{}, &value_type::first)) {
+      std::ranges::stable_sort(entries_, std::less<>{}, &value_type::first);
+    }
+    auto out = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      auto const next = std::next(it);
+      if (next != entries_.end() && next->first == it->first) {
+        continue;
+      }
+      if (out != it) {
+        *out = std::move(*it);
+      }
+      ++out;
+    }
+    entries_.erase(out, entries_.end());
+  }
+
+  container_t entries_;
+};
+
+}  // namespace openapi
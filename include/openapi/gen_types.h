@@ -21,7 +21,10 @@ enum class type {
   kString,
   kArray,
   kObject,
-  kDate
+  kDate,
+  kPolyline,
+  kUuid,
+  kFullDate
 };
 
 type to_type(YAML::Node const& schema);
@@ -51,6 +54,7 @@ void gen_member_init(YAML::Node const& root,
                      std::ostream& source);
 
 void write_params(YAML::Node const& root,
+                  std::string_view path,
                   YAML::Node const&,
                   std::ostream& header,
                   std::ostream& source);
@@ -61,4 +65,4 @@ void write_types(YAML::Node const&,
                  std::ostream& source,
                  std::optional<std::string_view> ns);
 
-}  // namespace openapi
\ No newline at end of file
+}  // namespace openapi
@@ -1,10 +1,30 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
 #include "boost/json.hpp"
 
 #include "utl/verify.h"
 
 #include "openapi/date_time.h"
+#include "openapi/enum_set.h"
+#include "openapi/fixed_point.h"
+#include "openapi/flat_map.h"
+#include "openapi/lazy.h"
+#include "openapi/polyline.h"
+#include "openapi/presence.h"
+#include "openapi/rows.h"
+#include "openapi/serialized_size.h"
+#include "openapi/uuid.h"
 
 namespace openapi {
 
@@ -13,38 +33,657 @@ namespace json = boost::json;
 date_time_t tag_invoke(json::value_to_tag<date_time_t>, json::value const&);
 void tag_invoke(json::value_from_tag, json::value&, date_time_t const);
 
-template <class T>
-void extract_member(json::object const& o, T& t, json::string_view key) {
+date_t tag_invoke(json::value_to_tag<date_t>, json::value const&);
+void tag_invoke(json::value_from_tag, json::value&, date_t const);
+
+uuid tag_invoke(json::value_to_tag<uuid>, json::value const&);
+void tag_invoke(json::value_from_tag, json::value&, uuid const&);
+
+// Fixed-point numbers are plain JSON numbers. Decoded from their shortest
+// decimal form with from_chars, so the DOM rounds like the text paths
+// (1.005 becomes 1.01, not 1.00 as 1.005 * 100 in double would).
+template <unsigned Precision>
+fixed_point<Precision> tag_invoke(json::value_to_tag<fixed_point<Precision>>,
+                                  json::value const& jv) {
+  auto buf = std::array<char, 32U>{};
+  auto const print = [&](auto const v) {
+    return std::to_chars(buf.data(), buf.data() + buf.size(), v).ptr;
+  };
+  auto const end = jv.is_double()  ? print(jv.get_double())
+                   : jv.is_int64() ? print(jv.get_int64())
+                                   : print(jv.as_uint64());
+  auto x = fixed_point<Precision>{};
+  auto const [ptr, ec] = from_chars(buf.data(), end, x);
+  utl::verify(ec == std::errc{} && ptr == end, "invalid fixed point number {}",
+              std::string_view{buf.data(), end});
+  return x;
+}
+
+template <unsigned Precision>
+void tag_invoke(json::value_from_tag,
+                json::value& jv,
+                fixed_point<Precision> const x) {
+  jv = x.to_double();
+}
+
+template <typename E, std::size_t K>
+enum_set<E, K> tag_invoke(json::value_to_tag<enum_set<E, K>>,
+                          json::value const& jv) {
+  auto s = enum_set<E, K>{};
+  for (auto const& x : jv.as_array()) {
+    auto const e = json::value_to<E>(x);
+    utl::verify(!s.contains(e), "duplicate enum set value {}",
+                json::serialize(x));
+    s.insert(e);
+  }
+  return s;
+}
+
+template <typename E, std::size_t K>
+void tag_invoke(json::value_from_tag,
+                json::value& jv,
+                enum_set<E, K> const& s) {
+  auto& arr = jv.emplace_array();
+  arr.reserve(s.size());
+  for (auto const e : s) {
+    arr.emplace_back(json::value_from(e, arr.storage()));
+  }
+}
+
+// JSON conversion of generated struct members. Members with an
+// x-cpp-codec use that type instead, which has to provide the same static
+// functions for the member type. It may also provide
+// `static std::size_t serialized_size(T const&)`.
+struct default_codec {
+  template <class T>
+  static void decode(json::value const& jv, T& t) {
+    t = json::value_to<T>(jv);
+  }
+
+  template <class T>
+  static void encode(T const& t, json::value& jv) {
+    json::value_from(t, jv);
+  }
+};
+
+template <class T, class Codec>
+json::value encode_value(T const& t, json::storage_ptr sp, Codec const&) {
+  if constexpr (std::is_same_v<Codec, default_codec>) {
+    return json::value_from(t, std::move(sp));
+  } else {
+    auto jv = json::value{std::move(sp)};
+    Codec::encode(t, jv);
+    return jv;
+  }
+}
+
+template <typename V>
+flat_map<V> tag_invoke(json::value_to_tag<flat_map<V>>, json::value const& jv) {
+  auto const& o = jv.as_object();
+  auto entries = typename flat_map<V>::container_t{};
+  entries.reserve(o.size());
+  for (auto const& kv : o) {
+    entries.emplace_back(std::string{kv.key()}, json::value_to<V>(kv.value()));
+  }
+  return flat_map<V>{std::move(entries)};
+}
+
+template <typename V>
+void tag_invoke(json::value_from_tag, json::value& jv, flat_map<V> const& m) {
+  auto& o = jv.emplace_object();
+  o.reserve(m.size());
+  for (auto const& [key, value] : m) {
+    o.emplace(key, json::value_from(value, o.storage()));
+  }
+}
+
+template <typename T>
+T row_value(json::value const& jv) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return jv.to_number<T>();
+  } else {
+    return json::value_to<T>(jv);
+  }
+}
+
+template <typename T, std::size_t N>
+fixed_rows<T, N> tag_invoke(json::value_to_tag<fixed_rows<T, N>>,
+                            json::value const& jv) {
+  auto const& arr = jv.as_array();
+  auto r = fixed_rows<T, N>{};
+  r.reserve(arr.size());
+  for (auto const& row : arr) {
+    auto const& values = row.as_array();
+    utl::verify(values.size() == N, "expected {} values per row, got {}", N,
+                values.size());
+    for (auto const& x : values) {
+      r.data_.push_back(row_value<T>(x));
+    }
+  }
+  return r;
+}
+
+template <typename T>
+ragged_rows<T> tag_invoke(json::value_to_tag<ragged_rows<T>>,
+                          json::value const& jv) {
+  auto const& arr = jv.as_array();
+  auto n_values = std::size_t{0U};
+  for (auto const& row : arr) {
+    n_values += row.as_array().size();
+  }
+  auto r = ragged_rows<T>{};
+  r.reserve(arr.size(), n_values);
+  for (auto const& row : arr) {
+    for (auto const& x : row.get_array()) {
+      r.data_.push_back(row_value<T>(x));
+    }
+    r.end_row();
+  }
+  return r;
+}
+
+template <typename Rows>
+void write_rows(json::value& jv, Rows const& r) {
+  auto& arr = jv.emplace_array();
+  arr.reserve(r.size());
+  for (auto i = std::size_t{0U}; i != r.size(); ++i) {
+    auto& values = arr.emplace_back(json::array(arr.storage())).as_array();
+    values.reserve(r[i].size());
+    for (auto const x : r[i]) {
+      values.emplace_back(json::value_from(x, values.storage()));
+    }
+  }
+}
+
+template <typename T, std::size_t N>
+void tag_invoke(json::value_from_tag,
+                json::value& jv,
+                fixed_rows<T, N> const& r) {
+  write_rows(jv, r);
+}
+
+template <typename T>
+void tag_invoke(json::value_from_tag,
+                json::value& jv,
+                ragged_rows<T> const& r) {
+  write_rows(jv, r);
+}
+
+template <unsigned Precision>
+polyline<Precision> tag_invoke(json::value_to_tag<polyline<Precision>>,
+                               json::value const& jv) {
+  auto p = polyline<Precision>{};
+  decode_polyline(jv.as_string(), p);
+  return p;
+}
+
+template <unsigned Precision>
+void tag_invoke(json::value_from_tag,
+                json::value& jv,
+                polyline<Precision> const& p) {
+  auto& s = jv.emplace_string();
+  s.reserve(encoded_size(p));
+  encode_polyline(p, s);
+}
+
+// Decodes the raw JSON text of a lazily decoded member. Rows are read
+// without building the JSON DOM.
+template <typename T>
+void decode_raw(std::string_view s, T& t) {
+  t = json::value_to<T>(json::parse(s));
+}
+
+template <typename T, std::size_t N>
+void decode_raw(std::string_view s, fixed_rows<T, N>& r) {
+  parse_rows(s, r);
+}
+
+template <typename T>
+void decode_raw(std::string_view s, ragged_rows<T>& r) {
+  parse_rows(s, r);
+}
+
+template <class T, class Codec = default_codec>
+void extract_member(json::object const& o,
+                    T& t,
+                    json::string_view key,
+                    Codec const& = {}) {
   auto const it = o.find(key);
   if (it == o.end()) {
     [[unlikely]];
     throw utl::fail("key {} not found in {}", key, json::serialize(o));
   }
-  t = json::value_to<T>(it->value());
+  Codec::decode(it->value(), t);
 }
 
-template <class T>
+template <class T, class Codec = default_codec>
 void extract_member(json::object const& o,
                     std::optional<T>& t,
-                    json::string_view key) {
+                    json::string_view key,
+                    Codec const& = {}) {
   auto const it = o.find(key);
   if (it != o.end()) {
-    t = json::value_to<T>(it->value());
+    Codec::decode(it->value(), t.emplace());
   }
 }
 
-template <class T>
+template <class T, std::size_t N, class Codec = default_codec>
+void extract_member(json::object const& o,
+                    T& t,
+                    presence<N>& p,
+                    std::size_t const bit,
+                    json::string_view key,
+                    Codec const& = {}) {
+  auto const it = o.find(key);
+  if (it != o.end()) {
+    Codec::decode(it->value(), t);
+    p.set(bit);
+  }
+}
+
+template <class T, class Codec = default_codec>
+void decode_lazy(std::string_view raw,
+                 lazy_span const s,
+                 T& t,
+                 json::string_view key,
+                 Codec const& = {}) {
+  if (!s.present()) {
+    [[unlikely]];
+    throw utl::fail("key {} not found in {}", key, raw);
+  }
+  if constexpr (std::is_same_v<Codec, default_codec>) {
+    decode_raw(s.view(raw), t);
+  } else {
+    Codec::decode(json::parse(s.view(raw)), t);
+  }
+}
+
+template <class T, class Codec = default_codec>
+void decode_lazy(std::string_view raw,
+                 lazy_span const s,
+                 std::optional<T>& t,
+                 json::string_view,
+                 Codec const& = {}) {
+  if (!s.present()) {
+    return;
+  }
+  if constexpr (std::is_same_v<Codec, default_codec>) {
+    decode_raw(s.view(raw), t.emplace());
+  } else {
+    Codec::decode(json::parse(s.view(raw)), t.emplace());
+  }
+}
+
+template <class T, class Codec = default_codec>
 void write_member(json::object& o,
                   std::optional<T> const& t,
-                  json::string_view key) {
+                  json::string_view key,
+                  Codec const& codec = {}) {
+  if (t.has_value()) {
+    o.emplace(key, encode_value(*t, o.storage(), codec));
+  }
+}
+
+template <class T, class Codec = default_codec>
+void write_member(json::object& o,
+                  T const& t,
+                  json::string_view key,
+                  Codec const& codec = {}) {
+  o.emplace(key, encode_value(t, o.storage(), codec));
+}
+
+template <class T, std::size_t N, class Codec = default_codec>
+void write_member(json::object& o,
+                  T const& t,
+                  presence<N> const& p,
+                  std::size_t const bit,
+                  json::string_view key,
+                  Codec const& codec = {}) {
+  if (p.test(bit)) {
+    o.emplace(key, encode_value(t, o.storage(), codec));
+  }
+}
+
+// Member sizes for members with an x-cpp-codec. Codecs without their own
+// serialized_size are measured by encoding.
+template <class T, class Codec>
+std::size_t member_size(T const& t,
+                        std::size_t const key_size,
+                        std::size_t& n_members,
+                        Codec const& codec) {
+  ++n_members;
+  if constexpr (requires { Codec::serialized_size(t); }) {
+    return key_size + Codec::serialized_size(t);
+  } else {
+    return key_size + serialized_size(encode_value(t, {}, codec));
+  }
+}
+
+template <class T, class Codec>
+std::size_t member_size(std::optional<T> const& t,
+                        std::size_t const key_size,
+                        std::size_t& n_members,
+                        Codec const& codec) {
+  return t.has_value() ? member_size(*t, key_size, n_members, codec) : 0U;
+}
+
+template <class T, std::size_t N, class Codec>
+std::size_t member_size(T const& t,
+                        presence<N> const& p,
+                        std::size_t const bit,
+                        std::size_t const key_size,
+                        std::size_t& n_members,
+                        Codec const& codec) {
+  return p.test(bit) ? member_size(t, key_size, n_members, codec) : 0U;
+}
+
+// Adds the merge patch that turns a into b to o (nothing if they are
+// equal). Objects are diffed key by key with null for removed keys.
+void diff_value(json::object& o,
+                json::value const& a,
+                json::value const& b,
+                json::string_view key);
+
+// JSON Merge Patch (RFC 7386): generated structs and flat_maps are diffed
+// and patched member by member. Other values that encode to JSON objects
+// (free-form maps, x-cpp-codec types) are diffed on their encoding, so
+// removed keys become null. Everything else is replaced as a whole.
+template <class T, class Codec = default_codec>
+void diff_member(json::object& o,
+                 T const& a,
+                 T const& b,
+                 json::string_view key,
+                 Codec const& codec = {}) {
+  if constexpr (std::is_same_v<Codec, default_codec> &&
+                requires(json::object& patch) { diff(a, b, patch); }) {
+    auto patch = json::object{o.storage()};
+    diff(a, b, patch);
+    if (!patch.empty()) {
+      o.emplace(key, std::move(patch));
+    }
+  } else if (a != b) {
+    auto b_json = encode_value(b, o.storage(), codec);
+    if (b_json.is_object()) {
+      diff_value(o, encode_value(a, o.storage(), codec), b_json, key);
+    } else {
+      o.emplace(key, std::move(b_json));
+    }
+  }
+}
+
+template <class T, class Codec = default_codec>
+void diff_member(json::object& o,
+                 std::optional<T> const& a,
+                 std::optional<T> const& b,
+                 json::string_view key,
+                 Codec const& codec = {}) {
+  if (!b.has_value()) {
+    if (a.has_value()) {
+      o.emplace(key, nullptr);
+    }
+  } else if (!a.has_value()) {
+    o.emplace(key, encode_value(*b, o.storage(), codec));
+  } else {
+    diff_member(o, *a, *b, key, codec);
+  }
+}
+
+template <class T, std::size_t N, class Codec = default_codec>
+void diff_member(json::object& o,
+                 T const& a,
+                 presence<N> const& a_present,
+                 T const& b,
+                 presence<N> const& b_present,
+                 std::size_t const bit,
+                 json::string_view key,
+                 Codec const& codec = {}) {
+  if (!b_present.test(bit)) {
+    if (a_present.test(bit)) {
+      o.emplace(key, nullptr);
+    }
+  } else if (!a_present.test(bit)) {
+    o.emplace(key, encode_value(b, o.storage(), codec));
+  } else {
+    diff_member(o, a, b, key, codec);
+  }
+}
+
+template <class T, class Codec = default_codec>
+void patch_value(T& t, json::value const& v, Codec const& = {}) {
+  if constexpr (std::is_same_v<Codec, default_codec> &&
+                requires { apply_patch(t, v); }) {
+    apply_patch(t, v);
+  } else {
+    Codec::decode(v, t);
+  }
+}
+
+template <class T, class Codec = default_codec>
+void patch_member(json::object const& patch,
+                  T& t,
+                  json::string_view key,
+                  Codec const& codec = {}) {
+  auto const it = patch.find(key);
+  if (it == patch.end()) {
+    return;
+  }
+  if (it->value().is_null()) {
+    [[unlikely]];
+    throw utl::fail("patch removes required member {}", key);
+  }
+  patch_value(t, it->value(), codec);
+}
+
+template <class T, class Codec = default_codec>
+void patch_member(json::object const& patch,
+                  std::optional<T>& t,
+                  json::string_view key,
+                  Codec const& codec = {}) {
+  auto const it = patch.find(key);
+  if (it == patch.end()) {
+    return;
+  }
+  if (it->value().is_null()) {
+    t = std::nullopt;
+  } else if (t.has_value()) {
+    patch_value(*t, it->value(), codec);
+  } else {
+    Codec::decode(it->value(), t.emplace());
+  }
+}
+
+template <class T, std::size_t N, class Codec = default_codec>
+void patch_member(json::object const& patch,
+                  T& t,
+                  presence<N>& p,
+                  std::size_t const bit,
+                  json::string_view key,
+                  Codec const& codec = {}) {
+  auto const it = patch.find(key);
+  if (it == patch.end()) {
+    return;
+  }
+  if (it->value().is_null()) {
+    t = T{};
+    p.reset(bit);
+  } else if (p.test(bit)) {
+    patch_value(t, it->value(), codec);
+  } else {
+    Codec::decode(it->value(), t);
+    p.set(bit);
+  }
+}
+
+template <typename V>
+void diff(flat_map<V> const& a, flat_map<V> const& b, json::object& patch) {
+  auto it_a = a.begin();
+  auto it_b = b.begin();
+  while (it_a != a.end() || it_b != b.end()) {
+    if (it_b == b.end() || (it_a != a.end() && it_a->first < it_b->first)) {
+      patch.emplace(it_a->first, nullptr);
+      ++it_a;
+    } else if (it_a == a.end() || it_b->first < it_a->first) {
+      patch.emplace(it_b->first,
+                    json::value_from(it_b->second, patch.storage()));
+      ++it_b;
+    } else {
+      diff_member(patch, it_a->second, it_b->second, it_b->first);
+      ++it_a;
+      ++it_b;
+    }
+  }
+}
+
+// Patches a copy, so m is unchanged if the patch is rejected.
+template <typename V>
+void apply_patch(flat_map<V>& m, json::value const& patch) {
+  if (!patch.is_object()) {
+    m = json::value_to<flat_map<V>>(patch);
+    return;
+  }
+  auto x = m;
+  for (auto const& [key, value] : patch.as_object()) {
+    if (value.is_null()) {
+      x.erase(key);
+    } else if (auto const it = x.find(key); it != x.end()) {
+      patch_value(it->second, value);
+    } else {
+      x.emplace(std::string{key}, json::value_to<V>(value));
+    }
+  }
+  m = std::move(x);
+}
+
+template <class T, class Fields>
+void write_projected(json::value& jv,
+                     std::optional<T> const& v,
+                     Fields const& f);
+
+template <class T, class Fields>
+void write_projected(json::value& jv,
+                     std::vector<T> const& v,
+                     Fields const& f) {
+  auto& arr = jv.emplace_array();
+  arr.reserve(v.size());
+  for (auto const& x : v) {
+    write_projected(arr.emplace_back(nullptr), x, f);
+  }
+}
+
+template <class T, class Fields>
+void write_projected(json::value& jv,
+                     std::optional<T> const& v,
+                     Fields const& f) {
+  if (v.has_value()) {
+    write_projected(jv, *v, f);
+  } else {
+    jv = nullptr;
+  }
+}
+
+// Encodes only the members selected by the generated XFields mask.
+template <class T, class Fields>
+json::value to_json(T const& x,
+                    Fields const& f,
+                    json::storage_ptr sp = json::storage_ptr{}) {
+  auto jv = json::value{std::move(sp)};
+  write_projected(jv, x, f);
+  return jv;
+}
+
+template <class T, class Fields>
+void write_projected_member(json::object& o,
+                            T const& t,
+                            Fields const& f,
+                            json::string_view key) {
+  write_projected(o.emplace(key, nullptr).first->value(), t, f);
+}
+
+template <class T, class Fields>
+void write_projected_member(json::object& o,
+                            std::optional<T> const& t,
+                            Fields const& f,
+                            json::string_view key) {
   if (t.has_value()) {
-    o.emplace(key, json::value_from(t));
+    write_projected_member(o, *t, f, key);
+  }
+}
+
+template <class T, class Fields, std::size_t N>
+void write_projected_member(json::object& o,
+                            T const& t,
+                            Fields const& f,
+                            presence<N> const& p,
+                            std::size_t const bit,
+                            json::string_view key) {
+  if (p.test(bit)) {
+    write_projected_member(o, t, f, key);
+  }
+}
+
+template <class T>
+void extract_column(json::object const& o,
+                    std::vector<T>& col,
+                    json::string_view key) {
+  auto const it = o.find(key);
+  if (it == o.end()) {
+    [[unlikely]];
+    throw utl::fail("key {} not found in {}", key, json::serialize(o));
+  }
+  col.emplace_back(json::value_to<T>(it->value()));
+}
+
+template <class T>
+void extract_column(json::object const& o,
+                    std::vector<T>& col,
+                    std::vector<bool>& valid,
+                    json::string_view key) {
+  auto const it = o.find(key);
+  if (it != o.end()) {
+    col.emplace_back(json::value_to<T>(it->value()));
+    valid.push_back(true);
+  } else {
+    col.emplace_back();
+    valid.push_back(false);
   }
 }
 
 template <class T>
-void write_member(json::object& o, T const& t, json::string_view key) {
-  o.emplace(key, json::value_from(t));
+void write_column(json::object& o,
+                  std::vector<T> const& col,
+                  std::size_t const i,
+                  json::string_view key) {
+  o.emplace(key, json::value_from(col[i], o.storage()));
+}
+
+template <class T>
+void write_column(json::object& o,
+                  std::vector<T> const& col,
+                  std::vector<bool> const& valid,
+                  std::size_t const i,
+                  json::string_view key) {
+  if (valid[i]) {
+    o.emplace(key, json::value_from(col[i], o.storage()));
+  }
+}
+
+// Serializes to compact JSON with a single allocation of the size given by
+// serialized_size. A wrong estimate only costs a reallocation.
+template <typename T>
+std::string serialize(T const& x) {
+  auto const jv = json::value_from(x);
+  auto s = std::string{};
+  s.resize(serialized_size(x));
+  auto sr = json::serializer{};
+  sr.reset(&jv);
+  auto n = sr.read(s.data(), s.size()).size();
+  while (!sr.done()) {
+    s.resize(std::max(2U * s.size(), std::size_t{64U}));
+    n += sr.read(s.data() + n, s.size() - n).size();
+  }
+  assert(n == serialized_size(x) && "serialized_size mismatch");
+  s.resize(n);
+  return s;
 }
 
 template <typename T>
@@ -58,4 +697,4 @@ void parse(std::string_view s, T& x) {
 
 inline void parse(std::string_view s, std::string_view& x) { x = s; }
 
-}  // namespace openapi
\ No newline at end of file
+}  // namespace openapi
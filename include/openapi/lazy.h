@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace openapi {
+
+// Location of a member's raw JSON value inside the buffer of a generated
+// XLazy type. Valid JSON values are never empty, so size 0 means absent.
+struct lazy_span {
+  static lazy_span of(std::string_view raw, std::string_view value) {
+    return {static_cast<std::uint32_t>(value.data() - raw.data()),
+            static_cast<std::uint32_t>(value.size())};
+  }
+
+  bool present() const { return size_ != 0U; }
+
+  std::string_view view(std::string_view raw) const {
+    return raw.substr(begin_, size_);
+  }
+
+  std::uint32_t begin_{0U};
+  std::uint32_t size_{0U};
+};
+
+using member_fn_t = void (*)(void*, std::string_view key, std::string_view);
+
+// Validates a JSON document in a single pass and reports the raw value of
+// every top-level member. Throws if the input is not a valid JSON object.
+void scan_object(std::string_view json, member_fn_t, void* ctx);
+
+template <typename Fn>
+void for_each_member(std::string_view json, Fn&& fn) {
+  scan_object(
+      json,
+      [](void* ctx, std::string_view key, std::string_view value) {
+        (*static_cast<std::remove_reference_t<Fn>*>(ctx))(key, value);
+      },
+      &fn);
+}
+
+// Generated XLazy wrapper of a schema with x-lazy.
+template <typename T>
+using lazy = typename T::lazy_t;
+
+}  // namespace openapi
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string_view>
+
+#include "openapi/trace.h"
+
+namespace openapi {
+
+#ifdef OPENAPI_METRICS
+constexpr auto const kMetrics = true;
+#else
+constexpr auto const kMetrics = false;
+#endif
+
+// Lock-free log-linear (HDR style) histogram. Values below kSubBuckets
+// have a bucket each. Every power of two range [2^e, 2^(e+1)) above is
+// split into kSubBuckets linear sub-buckets, so a bucket's width is at most
+// 1/kSubBuckets of its lower bound. Values of 2^48 and more are only
+// counted in count_ and sum_. Without OPENAPI_METRICS there are no buckets.
+struct histogram {
+  static constexpr auto const kSubBits = 3U;
+  static constexpr auto const kSubBuckets = std::size_t{1U} << kSubBits;
+  static constexpr auto const kMaxBits = 48U;
+  static constexpr auto const kBuckets =
+      (kMaxBits - kSubBits + 1U) * kSubBuckets;
+
+  static constexpr std::size_t bucket(std::uint64_t const v) noexcept {
+    if (v < kSubBuckets) {
+      return static_cast<std::size_t>(v);
+    }
+    auto const e = static_cast<unsigned>(std::bit_width(v)) - 1U;
+    auto const sub = (v >> (e - kSubBits)) & (kSubBuckets - 1U);
+    return (e - kSubBits + 1U) * kSubBuckets + static_cast<std::size_t>(sub);
+  }
+
+  static constexpr std::uint64_t lower_bound(std::size_t const i) noexcept {
+    if (i < kSubBuckets) {
+      return i;
+    }
+    auto const e = static_cast<unsigned>(i / kSubBuckets) + kSubBits - 1U;
+    return (kSubBuckets + i % kSubBuckets) << (e - kSubBits);
+  }
+
+  // Largest value counted in bucket i (the Prometheus "le" label).
+  static constexpr std::uint64_t upper_bound(std::size_t const i) noexcept {
+    return lower_bound(i + 1U) - 1U;
+  }
+
+  void record(std::uint64_t const v) noexcept {
+    if constexpr (kMetrics) {
+      if (auto const i = bucket(v); i < kBuckets) {
+        buckets_[i].fetch_add(1U, std::memory_order_relaxed);
+      }
+      count_.fetch_add(1U, std::memory_order_relaxed);
+      sum_.fetch_add(v, std::memory_order_relaxed);
+    }
+  }
+
+  std::array<std::atomic<std::uint64_t>, kMetrics ? kBuckets : 0U> buckets_{};
+  std::atomic<std::uint64_t> count_{0U};
+  std::atomic<std::uint64_t> sum_{0U};
+};
+
+// Codec metrics of one operation (by operationId).
+// Durations are in nanoseconds, sizes in bytes.
+struct operation_metrics {
+  explicit operation_metrics(std::string_view operation_id)
+      : operation_id_{operation_id} {}
+
+  void count_error() noexcept {
+    if constexpr (kMetrics) {
+      errors_.fetch_add(1U, std::memory_order_relaxed);
+    }
+  }
+
+  std::string_view operation_id_;
+  histogram params_parse_ns_;
+  histogram body_decode_ns_;
+  histogram response_encode_ns_;
+  histogram request_bytes_;
+  histogram response_bytes_;
+  std::atomic<std::uint64_t> errors_{0U};
+};
+
+// Records the lifetime of the timer in a histogram and as a trace span.
+// Compiles to nothing without OPENAPI_METRICS and OPENAPI_TRACE.
+struct scoped_timer {
+  scoped_timer(histogram& h, char const* trace_name) noexcept {
+    if constexpr (kMetrics || trace::kEnabled) {
+      h_ = &h;
+      trace_name_ = trace_name;
+      start_ = trace::now();
+    }
+  }
+
+  ~scoped_timer() {
+    if constexpr (kMetrics || trace::kEnabled) {
+      auto const end = trace::now();
+      h_->record(static_cast<std::uint64_t>(end - start_));
+      if constexpr (trace::kEnabled) {
+        trace::thread_ring().push({trace_name_, start_, end});
+      }
+    }
+  }
+
+  scoped_timer(scoped_timer const&) = delete;
+  scoped_timer& operator=(scoped_timer const&) = delete;
+
+  histogram* h_{nullptr};
+  char const* trace_name_{nullptr};
+  std::int64_t start_{0};
+};
+
+// Prometheus text exposition format (version 0.0.4).
+void write_prometheus(std::ostream&,
+                      std::span<operation_metrics* const> operations);
+
+}  // namespace openapi
@@ -2,15 +2,29 @@
 
 #include "boost/url/params_view.hpp"
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iterator>
 #include <sstream>
+#include <string>
 #include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "fmt/format.h"
+
 #include "utl/parser/arg_parser.h"
 #include "utl/verify.h"
 
 #include "openapi/date_time.h"
+#include "openapi/enum_set.h"
+#include "openapi/fixed_point.h"
 #include "openapi/missing_param_exception.h"
+#include "openapi/polyline.h"
+#include "openapi/uuid.h"
 
 namespace openapi {
 
@@ -34,17 +48,259 @@ void parse(std::string_view s, T& v) {
   utl::parse_arg(cs, v);
 }
 
+// Narrow numbers (from format or minimum/maximum) are read with
+// std::from_chars, which rejects values outside of the type's range.
+template <typename T>
+  requires(std::is_arithmetic_v<T> && !Primitive<T>)
+void parse(std::string_view s, T& v) {
+  auto const [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+  utl::verify(ec != std::errc::result_out_of_range, "number {} out of range",
+              s);
+  utl::verify(ec == std::errc{} && ptr == s.data() + s.size(),
+              "invalid number {}", s);
+}
+
+template <unsigned Precision>
+void parse(std::string_view s, fixed_point<Precision>& v) {
+  auto const [ptr, ec] = from_chars(s.data(), s.data() + s.size(), v);
+  utl::verify(ec == std::errc{} && ptr == s.data() + s.size(),
+              "invalid decimal {}", s);
+}
+
+template <unsigned Precision>
+void parse(std::string_view s, polyline<Precision>& v) {
+  decode_polyline(s, v);
+}
+
 template <typename T>
 void parse(std::string_view s, std::vector<T>& v) {
+  v.reserve(v.size() + static_cast<std::size_t>(std::ranges::count(s, ',')) +
+            1U);
   utl::for_each_token(
       s, ',', [&](auto&& token) { parse(token.view(), v.emplace_back()); });
 }
 
+template <typename E, std::size_t K>
+void parse(std::string_view s, enum_set<E, K>& v) {
+  v.clear();
+  utl::for_each_token(s, ',', [&](auto&& token) {
+    auto e = E{};
+    parse(token.view(), e);
+    utl::verify(!v.contains(e), "duplicate enum set value {}", token.view());
+    v.insert(e);
+  });
+}
+
 template <typename T>
 void parse(std::string_view s, std::optional<T>& v) {
   auto x = T{};
   parse(s, x);
-  v = x;
+  v = std::move(x);
+}
+
+// Writes query parameter values (the inverse of parse) without allocating
+// as long as the value fits into the inline storage of the buffer.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+void format_param(fmt::memory_buffer& buf, T const x) {
+  fmt::format_to(std::back_inserter(buf), "{}", x);
+}
+
+inline void format_param(fmt::memory_buffer& buf, bool const x) {
+  buf.push_back(x ? '1' : '0');
+}
+
+inline void format_param(fmt::memory_buffer& buf, std::string_view x) {
+  buf.append(x.data(), x.data() + x.size());
+}
+
+inline void format_param(fmt::memory_buffer& buf, date_time_t const& x) {
+  auto tmp = date_time_buf_t{};
+  format_param(buf, format(x, tmp));
+}
+
+inline void format_param(fmt::memory_buffer& buf, date_t const x) {
+  auto tmp = date_buf_t{};
+  format_param(buf, format(x, tmp));
+}
+
+inline void format_param(fmt::memory_buffer& buf, uuid const& x) {
+  auto tmp = uuid_buf_t{};
+  format_param(buf, format(x, tmp));
+}
+
+template <unsigned Precision>
+void format_param(fmt::memory_buffer& buf, fixed_point<Precision> const x) {
+  auto tmp = std::array<char, fixed_point<Precision>::kMaxChars>{};
+  auto const end = to_chars(tmp.data(), tmp.data() + tmp.size(), x).ptr;
+  buf.append(tmp.data(), end);
+}
+
+template <unsigned Precision>
+void format_param(fmt::memory_buffer& buf, polyline<Precision> const& x) {
+  encode_polyline(x, buf);
+}
+
+template <typename T>
+  requires requires(T const x) { to_str(x); }
+void format_param(fmt::memory_buffer& buf, T const x) {
+  format_param(buf, to_str(x));
+}
+
+template <typename T>
+void format_param(fmt::memory_buffer& buf, std::vector<T> const& v) {
+  auto first = true;
+  for (auto const& x : v) {
+    if (!first) {
+      buf.push_back(',');
+    }
+    first = false;
+    format_param(buf, x);
+  }
+}
+
+template <typename E, std::size_t K>
+void format_param(fmt::memory_buffer& buf, enum_set<E, K> const& v) {
+  auto first = true;
+  for (auto const e : v) {
+    if (!first) {
+      buf.push_back(',');
+    }
+    first = false;
+    format_param(buf, e);
+  }
+}
+
+// Decodes %XX escapes. Returns the input itself if there is nothing to
+// decode, otherwise a view of the decoded copy in buf.
+inline std::string_view pct_decode(std::string_view in, std::string& buf) {
+  if (in.find('%') == std::string_view::npos) {
+    return in;
+  }
+  auto const hex = [&](char const c) {
+    if (c >= '0' && c <= '9') {
+      return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      return c - 'A' + 10;
+    }
+    throw utl::fail("invalid percent-encoding: {}", in);
+  };
+  buf.clear();
+  buf.reserve(in.size());
+  for (auto i = std::size_t{0U}; i != in.size(); ++i) {
+    if (in[i] != '%') {
+      buf.push_back(in[i]);
+      continue;
+    }
+    utl::verify(i + 2U < in.size(), "invalid percent-encoding: {}", in);
+    buf.push_back(static_cast<char>(hex(in[i + 1U]) * 16 + hex(in[i + 2U])));
+    i += 2U;
+  }
+  return buf;
+}
+
+// Set of characters that are written without percent-encoding.
+struct pct_charset {
+  constexpr explicit pct_charset(std::string_view extra) {
+    for (auto c = 'a'; c <= 'z'; ++c) {
+      allowed_[static_cast<unsigned char>(c)] = true;
+    }
+    for (auto c = 'A'; c <= 'Z'; ++c) {
+      allowed_[static_cast<unsigned char>(c)] = true;
+    }
+    for (auto c = '0'; c <= '9'; ++c) {
+      allowed_[static_cast<unsigned char>(c)] = true;
+    }
+    for (auto const c : std::string_view{"-._~"}) {
+      allowed_[static_cast<unsigned char>(c)] = true;
+    }
+    for (auto const c : extra) {
+      allowed_[static_cast<unsigned char>(c)] = true;
+    }
+  }
+
+  std::array<bool, 256U> allowed_{};
+};
+
+// RFC 3986 pchar and query characters. The query set excludes the
+// delimiters "&", "=" and "+" so every value decodes unambiguously.
+inline constexpr auto const kPathChars = pct_charset{"!$&'()*+,;=:@"};
+inline constexpr auto const kQueryChars = pct_charset{"!$'()*,;:@/?"};
+
+template <typename Buffer>
+void append(Buffer& out, std::string_view s) {
+  out.append(s.data(), s.data() + s.size());
+}
+
+template <typename Buffer>
+void pct_encode(Buffer& out, std::string_view in, pct_charset const& set) {
+  constexpr auto const kHex = std::string_view{"0123456789ABCDEF"};
+  for (auto const c : in) {
+    auto const u = static_cast<unsigned char>(c);
+    if (set.allowed_[u]) {
+      out.push_back(c);
+    } else {
+      out.push_back('%');
+      out.push_back(kHex[u >> 4U]);
+      out.push_back(kHex[u & 0xFU]);
+    }
+  }
+}
+
+// Bound of a schema without minimum or maximum.
+struct no_bound {};
+
+template <auto Bound, typename T>
+bool is_below(T const x) {
+  using bound_t = std::remove_cvref_t<decltype(Bound)>;
+  if constexpr (std::is_same_v<bound_t, no_bound>) {
+    return false;
+  } else if constexpr (std::is_integral_v<bound_t> && std::is_integral_v<T>) {
+    return std::cmp_less(x, Bound);
+  } else {
+    return static_cast<double>(x) < static_cast<double>(Bound);
+  }
+}
+
+template <auto Bound, typename T>
+bool is_above(T const x) {
+  using bound_t = std::remove_cvref_t<decltype(Bound)>;
+  if constexpr (std::is_same_v<bound_t, no_bound>) {
+    return false;
+  } else if constexpr (std::is_integral_v<bound_t> && std::is_integral_v<T>) {
+    return std::cmp_greater(x, Bound);
+  } else {
+    return static_cast<double>(x) > static_cast<double>(Bound);
+  }
+}
+
+// Checks a decoded number against the minimum and maximum of its schema.
+template <auto Min, auto Max, typename T>
+T check_range(T x, std::string_view name) {
+  if constexpr (is_optional_v<T>) {
+    if (x.has_value()) {
+      check_range<Min, Max>(*x, name);
+    }
+  } else {
+    utl::verify(!is_below<Min>(x) && !is_above<Max>(x),
+                "{}: {} out of range", name, x);
+  }
+  return x;
+}
+
+// Parses a path parameter from the raw (percent-encoded) path segment.
+// Path parameters are required: an empty segment counts as missing.
+template <typename T>
+T parse_path_param(std::string_view raw, std::string_view name) {
+  if (raw.empty()) {
+    throw missing_param_exception{name};
+  }
+  auto buf = std::string{};
+  auto v = T{};
+  parse(pct_decode(raw, buf), v);
+  return v;
 }
 
 template <typename T>
@@ -66,4 +322,4 @@ T parse_param(boost::urls::params_view const& params,
   return default_value.has_value() ? T{*default_value} : T{};
 }
 
-}  // namespace openapi
\ No newline at end of file
+}  // namespace openapi
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "utl/verify.h"
+
+#include "openapi/fixed_point.h"
+#include "openapi/rows.h"
+
+namespace openapi {
+
+// Coordinate pairs of a `format: polyline` string (Google encoded polyline
+// algorithm) with Precision fraction digits (x-precision, default 5).
+template <unsigned Precision>
+struct polyline : fixed_rows<fixed_point<Precision>, 2U> {
+  auto operator<=>(polyline const&) const = default;
+};
+
+// Calls fn for each character of the encoded polyline.
+template <unsigned Precision, typename Fn>
+void for_each_polyline_char(polyline<Precision> const& p, Fn&& fn) {
+  auto prev = std::array<std::int64_t, 2U>{};
+  for (auto i = std::size_t{0U}; i != p.data_.size(); ++i) {
+    auto const value = static_cast<std::int64_t>(p.data_[i].value_);
+    auto const delta = value - prev[i % 2U];
+    prev[i % 2U] = value;
+
+    auto z = static_cast<std::uint64_t>(delta) << 1U;
+    if (delta < 0) {
+      z = ~z;
+    }
+    while (z >= 0x20U) {
+      fn(static_cast<char>((0x20U | (z & 0x1FU)) + 63U));
+      z >>= 5U;
+    }
+    fn(static_cast<char>(z + 63U));
+  }
+}
+
+template <unsigned Precision>
+std::size_t encoded_size(polyline<Precision> const& p) {
+  auto n = std::size_t{0U};
+  for_each_polyline_char(p, [&](char) { ++n; });
+  return n;
+}
+
+template <typename Buffer, unsigned Precision>
+void encode_polyline(polyline<Precision> const& p, Buffer& out) {
+  for_each_polyline_char(p, [&](char const c) { out.push_back(c); });
+}
+
+template <unsigned Precision>
+void decode_polyline(std::string_view s, polyline<Precision>& p) {
+  // Every value ends with a character without the continuation bit.
+  auto const n_values = static_cast<std::size_t>(
+      std::ranges::count_if(s, [](char const c) { return c < 63 + 0x20; }));
+  utl::verify(n_values % 2U == 0U, "polyline: odd number of values");
+
+  p.clear();
+  p.data_.resize(n_values);
+  auto prev = std::array<std::int64_t, 2U>{};
+  auto i = std::size_t{0U};
+  auto z = std::uint64_t{0U};
+  auto shift = 0U;
+  for (auto const c : s) {
+    auto const chunk = static_cast<std::uint64_t>(c - 63);
+    utl::verify(c >= 63 && c < 127 && shift < 60U,
+                "polyline: invalid character {}", c);
+    z |= (chunk & 0x1FU) << shift;
+    shift += 5U;
+    if (chunk >= 0x20U) {
+      continue;
+    }
+
+    auto const delta = (z & 1U) != 0U ? ~static_cast<std::int64_t>(z >> 1U)
+                                      : static_cast<std::int64_t>(z >> 1U);
+    auto const value = prev[i % 2U] + delta;
+    utl::verify(value >= std::numeric_limits<std::int32_t>::min() &&
+                    value <= std::numeric_limits<std::int32_t>::max(),
+                "polyline: value out of range");
+    prev[i % 2U] = value;
+    p.data_[i++] =
+        fixed_point<Precision>::from_raw(static_cast<std::int32_t>(value));
+    z = 0U;
+    shift = 0U;
+  }
+  utl::verify(shift == 0U, "polyline: truncated value");
+}
+
+}  // namespace openapi
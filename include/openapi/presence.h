@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace openapi {
+
+template <std::size_t N>
+using presence_word_t = std::conditional_t<
+    N <= 8U,
+    std::uint8_t,
+    std::conditional_t<
+        N <= 16U,
+        std::uint16_t,
+        std::conditional_t<N <= 32U, std::uint32_t, std::uint64_t>>>;
+
+// Records which of the N optional members of a generated struct are set.
+// Used instead of std::optional<T> for schemas with x-presence-bitmask.
+template <std::size_t N>
+struct presence {
+  using word_t = presence_word_t<N>;
+  static constexpr auto const kBits = sizeof(word_t) * 8U;
+
+  constexpr bool test(std::size_t const i) const {
+    return (words_[i / kBits] & mask(i)) != 0U;
+  }
+
+  constexpr void set(std::size_t const i) { words_[i / kBits] |= mask(i); }
+
+  constexpr void reset(std::size_t const i) {
+    words_[i / kBits] &= static_cast<word_t>(~mask(i));
+  }
+
+  constexpr std::size_t count() const {
+    auto n = std::size_t{0U};
+    for (auto const w : words_) {
+      n += static_cast<std::size_t>(std::popcount(w));
+    }
+    return n;
+  }
+
+  auto operator<=>(presence const&) const = default;
+
+  static constexpr word_t mask(std::size_t const i) {
+    return static_cast<word_t>(word_t{1U} << (i % kBits));
+  }
+
+  std::array<word_t, (N + kBits - 1U) / kBits> words_{};
+};
+
+}  // namespace openapi
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace openapi {
+
+enum class http_method : std::uint8_t {
+  kGet,
+  kPut,
+  kPost,
+  kDelete,
+  kOptions,
+  kHead,
+  kPatch,
+  kTrace
+};
+
+std::string_view to_str(http_method);
+void parse(std::string_view, http_method&);
+
+enum class route_status : std::uint8_t {
+  kFound,
+  kNotFound,
+  kMethodNotAllowed
+};
+
+// Splits the first segment off a path: "/a/b" yields "a" and leaves "/b".
+// Returns false once the path is exhausted.
+inline bool next_segment(std::string_view& path, std::string_view& segment) {
+  if (path.empty()) {
+    return false;
+  }
+  path.remove_prefix(1U);
+  auto const end = path.find('/');
+  segment = path.substr(0U, end);
+  path.remove_prefix(end == std::string_view::npos ? path.size() : end);
+  return true;
+}
+
+}  // namespace openapi
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "utl/verify.h"
+
+namespace openapi {
+
+// Array of numeric arrays with minItems == maxItems == N (e.g. coordinate
+// pairs). All values are stored row by row in one buffer.
+template <typename T, std::size_t N>
+struct fixed_rows {
+  static_assert(N != 0U);
+
+  std::size_t size() const { return data_.size() / N; }
+  bool empty() const { return data_.empty(); }
+
+  std::span<T const, N> operator[](std::size_t const i) const {
+    return std::span<T const, N>{data_.data() + i * N, N};
+  }
+
+  std::span<T, N> operator[](std::size_t const i) {
+    return std::span<T, N>{data_.data() + i * N, N};
+  }
+
+  void push_back(std::array<T, N> const& row) {
+    data_.insert(data_.end(), row.begin(), row.end());
+  }
+
+  void reserve(std::size_t const n_rows) { data_.reserve(n_rows * N); }
+  void clear() { data_.clear(); }
+
+  auto operator<=>(fixed_rows const&) const = default;
+
+  std::vector<T> data_;
+};
+
+// Array of numeric arrays of varying length. Row i holds the values
+// [offsets_[i], offsets_[i + 1]) of the shared buffer.
+template <typename T>
+struct ragged_rows {
+  std::size_t size() const { return offsets_.size() - 1U; }
+  bool empty() const { return size() == 0U; }
+
+  std::span<T const> operator[](std::size_t const i) const {
+    return {data_.data() + offsets_[i], data_.data() + offsets_[i + 1U]};
+  }
+
+  std::span<T> operator[](std::size_t const i) {
+    return {data_.data() + offsets_[i], data_.data() + offsets_[i + 1U]};
+  }
+
+  void push_back(std::span<T const> row) {
+    data_.insert(data_.end(), row.begin(), row.end());
+    end_row();
+  }
+
+  void push_back(std::initializer_list<T> row) {
+    push_back(std::span<T const>{row.begin(), row.size()});
+  }
+
+  // Closes the row made of the values appended to data_ since the last one.
+  void end_row() {
+    utl::verify(data_.size() <= std::numeric_limits<std::uint32_t>::max(),
+                "ragged_rows: too many values");
+    offsets_.push_back(static_cast<std::uint32_t>(data_.size()));
+  }
+
+  void reserve(std::size_t const n_rows, std::size_t const n_values) {
+    offsets_.reserve(n_rows + 1U);
+    data_.reserve(n_values);
+  }
+
+  void clear() {
+    data_.clear();
+    offsets_.resize(1U);
+  }
+
+  auto operator<=>(ragged_rows const&) const = default;
+
+  std::vector<T> data_;
+  std::vector<std::uint32_t> offsets_{0U};
+};
+
+// Returns the end of the JSON number starting at p or nullptr if there is
+// none. std::from_chars alone would also accept "nan", "inf" or "1.".
+inline char const* json_number_end(char const* p, char const* const end) {
+  auto const digits = [&]() {
+    auto const first = p;
+    while (p != end && *p >= '0' && *p <= '9') {
+      ++p;
+    }
+    return p != first;
+  };
+
+  if (p != end && *p == '-') {
+    ++p;
+  }
+  if (p != end && *p == '0') {
+    ++p;
+  } else if (!digits()) {
+    return nullptr;
+  }
+  if (p != end && *p == '.') {
+    ++p;
+    if (!digits()) {
+      return nullptr;
+    }
+  }
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    if (p != end && (*p == '+' || *p == '-')) {
+      ++p;
+    }
+    if (!digits()) {
+      return nullptr;
+    }
+  }
+  return p;
+}
+
+// Reads one row value from the JSON number [first, last). Like the DOM
+// path, integer rows accept integral numbers written with a fraction or
+// an exponent, e.g. 1.0 or 1e2.
+template <typename T>
+bool read_row_value(char const* const first, char const* const last, T& x) {
+  if constexpr (std::is_integral_v<T>) {
+    if (std::find_if(first, last, [](char const c) {
+          return c == '.' || c == 'e' || c == 'E';
+        }) != last ||
+        (std::is_unsigned_v<T> && *first == '-')) {
+      auto d = 0.0;
+      auto const [ptr, ec] = std::from_chars(first, last, d);
+      if (ec != std::errc{} || ptr != last || std::trunc(d) != d ||
+          d < static_cast<double>(std::numeric_limits<T>::min()) ||
+          d >= static_cast<double>(std::numeric_limits<T>::max()) + 1.0) {
+        return false;
+      }
+      x = static_cast<T>(d);
+      return true;
+    }
+  }
+  using std::from_chars;
+  auto const [ptr, ec] = from_chars(first, last, x);
+  return ec == std::errc{} && ptr == last;
+}
+
+// Reads a JSON array of numeric arrays straight from its text, appending
+// all values to data and calling end_row(row_size) after each row. Values
+// are checked against the JSON number grammar and then read with
+// std::from_chars or an overload found by ADL.
+// Skips the generic JSON DOM, which allocates a node per number. Only
+// x-lazy members read rows this way (decode_raw): value_to, the request
+// decoders and stream_decoder convert from an already built DOM.
+template <typename T, typename EndRow>
+void read_rows(std::string_view s, std::vector<T>& data, EndRow&& end_row) {
+  auto p = s.data();
+  auto const end = s.data() + s.size();
+  auto const skip_ws = [&]() {
+    while (p != end &&
+           (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+      ++p;
+    }
+  };
+  auto const expect = [&](char const c) {
+    skip_ws();
+    utl::verify(p != end && *p == c, "rows: expected '{}' at offset {}", c,
+                p - s.data());
+    ++p;
+  };
+  // Consumes ',' (true, more to come) or the closing ']' (false).
+  auto const next = [&]() {
+    skip_ws();
+    utl::verify(p != end && (*p == ',' || *p == ']'),
+                "rows: expected ',' or ']' at offset {}", p - s.data());
+    return *p++ == ',';
+  };
+  auto const close_if_empty = [&]() {
+    skip_ws();
+    if (p != end && *p == ']') {
+      ++p;
+      return true;
+    }
+    return false;
+  };
+
+  expect('[');
+  if (!close_if_empty()) {
+    do {
+      expect('[');
+      auto const row_begin = data.size();
+      if (!close_if_empty()) {
+        do {
+          skip_ws();
+          auto const number_end = json_number_end(p, end);
+          auto x = T{};
+          utl::verify(
+              number_end != nullptr && read_row_value(p, number_end, x),
+              "rows: invalid number at offset {}", p - s.data());
+          p = number_end;
+          data.push_back(x);
+        } while (next());
+      }
+      end_row(data.size() - row_begin);
+    } while (next());
+  }
+  skip_ws();
+  utl::verify(p == end, "rows: trailing characters at offset {}",
+              p - s.data());
+}
+
+template <typename T, std::size_t N>
+void parse_rows(std::string_view s, fixed_rows<T, N>& r) {
+  r.clear();
+  read_rows(s, r.data_, [](std::size_t const n) {
+    utl::verify(n == N, "rows: expected {} values per row, got {}", N, n);
+  });
+}
+
+template <typename T>
+void parse_rows(std::string_view s, ragged_rows<T>& r) {
+  r.clear();
+  read_rows(s, r.data_, [&](std::size_t) { r.end_row(); });
+}
+
+}  // namespace openapi
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "boost/json/fwd.hpp"
+
+#include "openapi/date_time.h"
+#include "openapi/enum_set.h"
+#include "openapi/fixed_point.h"
+#include "openapi/flat_map.h"
+#include "openapi/polyline.h"
+#include "openapi/presence.h"
+#include "openapi/rows.h"
+#include "openapi/uuid.h"
+
+namespace openapi {
+
+// Exact length of the compact JSON that boost::json::serialize produces for
+// a value, computed without writing any output.
+
+std::size_t serialized_size(std::string_view);
+std::size_t serialized_size(double);
+std::size_t serialized_size(date_time_t);
+std::size_t serialized_size(date_t);
+std::size_t serialized_size(boost::json::value const&);
+
+inline std::size_t serialized_size(std::string const& s) {
+  return serialized_size(std::string_view{s});
+}
+
+inline std::size_t serialized_size(bool const b) { return b ? 4U : 5U; }
+
+// Canonical form plus the quotes.
+inline std::size_t serialized_size(uuid const&) { return 38U; }
+
+template <unsigned Precision>
+std::size_t serialized_size(fixed_point<Precision> const x) {
+  return serialized_size(x.to_double());
+}
+
+inline std::size_t serialized_size(float const f) {
+  return serialized_size(static_cast<double>(f));
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+constexpr std::size_t serialized_size(T const x) {
+  auto n = std::size_t{x < 0 ? 2U : 1U};
+  for (auto v = x; v >= 10 || v <= -10; v /= 10) {
+    ++n;
+  }
+  return n;
+}
+
+template <typename T>
+std::size_t serialized_size(std::optional<T> const&);
+
+template <typename T>
+std::size_t serialized_size(std::vector<T> const&);
+
+template <typename V>
+std::size_t serialized_size(flat_map<V> const&);
+
+template <typename V>
+std::size_t serialized_size(std::map<std::string, V> const&);
+
+template <typename T>
+std::size_t serialized_size(std::optional<T> const& x) {
+  return x.has_value() ? serialized_size(*x) : 4U;
+}
+
+template <typename T>
+std::size_t serialized_size(std::vector<T> const& v) {
+  auto n = std::size_t{2U + (v.empty() ? 0U : v.size() - 1U)};
+  for (auto const& x : v) {
+    n += serialized_size(x);
+  }
+  return n;
+}
+
+template <typename T, std::size_t N>
+std::size_t serialized_size(fixed_rows<T, N> const& r) {
+  auto n = std::size_t{2U + (r.empty() ? 0U : r.size() - 1U)} +
+           r.size() * (2U + N - 1U);
+  for (auto const x : r.data_) {
+    n += serialized_size(x);
+  }
+  return n;
+}
+
+template <typename T>
+std::size_t serialized_size(ragged_rows<T> const& r) {
+  auto n = std::size_t{2U + (r.empty() ? 0U : r.size() - 1U)};
+  for (auto i = std::size_t{0U}; i != r.size(); ++i) {
+    auto const row = r[i];
+    n += 2U + (row.empty() ? 0U : row.size() - 1U);
+    for (auto const x : row) {
+      n += serialized_size(x);
+    }
+  }
+  return n;
+}
+
+template <typename E, std::size_t K>
+std::size_t serialized_size(enum_set<E, K> const& s) {
+  auto n = std::size_t{2U + (s.empty() ? 0U : s.size() - 1U)};
+  for (auto const e : s) {
+    n += serialized_size(e);
+  }
+  return n;
+}
+
+template <unsigned Precision>
+std::size_t serialized_size(polyline<Precision> const& p) {
+  auto n = std::size_t{2U};
+  for_each_polyline_char(p, [&](char const c) { n += c == '\\' ? 2U : 1U; });
+  return n;
+}
+
+template <typename Map>
+std::size_t serialized_map_size(Map const& m) {
+  auto n = std::size_t{2U + (m.empty() ? 0U : m.size() - 1U)};
+  for (auto const& [key, value] : m) {
+    n += serialized_size(std::string_view{key}) + 1U + serialized_size(value);
+  }
+  return n;
+}
+
+template <typename V>
+std::size_t serialized_size(flat_map<V> const& m) {
+  return serialized_map_size(m);
+}
+
+template <typename V>
+std::size_t serialized_size(std::map<std::string, V> const& m) {
+  return serialized_map_size(m);
+}
+
+// Size of `"key":value` for a generated struct member. key_size includes
+// the quotes and the colon. Absent optional members contribute nothing.
+template <typename T>
+std::size_t member_size(T const& t,
+                        std::size_t const key_size,
+                        std::size_t& n_members) {
+  ++n_members;
+  return key_size + serialized_size(t);
+}
+
+template <typename T>
+std::size_t member_size(std::optional<T> const& t,
+                        std::size_t const key_size,
+                        std::size_t& n_members) {
+  return t.has_value() ? member_size(*t, key_size, n_members) : 0U;
+}
+
+template <typename T, std::size_t N>
+std::size_t member_size(T const& t,
+                        presence<N> const& p,
+                        std::size_t const bit,
+                        std::size_t const key_size,
+                        std::size_t& n_members) {
+  return p.test(bit) ? member_size(t, key_size, n_members) : 0U;
+}
+
+constexpr std::size_t object_size(std::size_t const members_size,
+                                  std::size_t const n_members) {
+  return 2U + members_size + (n_members == 0U ? 0U : n_members - 1U);
+}
+
+}  // namespace openapi
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <string_view>
+
+#include "boost/json/fwd.hpp"
+
+namespace openapi {
+
+// Fixed-size output buffer. Full chunks are handed to the flush callback
+// (e.g. a socket write), so memory stays bounded by the buffer size.
+struct chunk_sink {
+  using flush_fn_t = std::function<void(std::string_view)>;
+
+  chunk_sink(std::span<char> buf, flush_fn_t flush);
+
+  void write(char);
+  void write(std::string_view);
+  void write(boost::json::value const&);
+  void flush();
+
+  std::span<char> buf_;
+  std::size_t used_{0U};
+  flush_fn_t flush_;
+};
+
+// Writes `[`, every element via write_element (found by ADL) and `]`.
+// Works for any input range, including std::generator<T const&>.
+template <std::ranges::input_range R>
+void stream_array(R&& r, chunk_sink& out) {
+  out.write('[');
+  auto first = true;
+  for (auto&& x : r) {
+    if (!first) {
+      out.write(',');
+    }
+    first = false;
+    write_element(out, x);
+  }
+  out.write(']');
+  out.flush();
+}
+
+}  // namespace openapi
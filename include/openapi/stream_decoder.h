@@ -0,0 +1,52 @@
+#pragma once
+
+#include <span>
+
+#include "boost/json/monotonic_resource.hpp"
+#include "boost/json/stream_parser.hpp"
+#include "boost/json/value_to.hpp"
+
+namespace openapi {
+
+// Decodes a T from input that arrives in pieces (TCP reads, chunked
+// transfer encoding). The parser keeps its state between feed() calls, so
+// no reassembly buffer is needed. Intermediate nodes live in a monotonic
+// arena that is recycled after every finish().
+template <typename T>
+struct stream_decoder {
+  stream_decoder() { p_.reset(boost::json::storage_ptr{&mr_}); }
+
+  stream_decoder(stream_decoder const&) = delete;
+  stream_decoder& operator=(stream_decoder const&) = delete;
+
+  // On malformed input the decoder is reset before the exception
+  // propagates, so it is ready for the next message.
+  void feed(std::span<char const> const chunk) {
+    try {
+      p_.write(chunk.data(), chunk.size());
+    } catch (...) {
+      reset();
+      throw;
+    }
+  }
+
+  T finish() {
+    struct reset_on_exit {
+      ~reset_on_exit() { d_.reset(); }
+      stream_decoder& d_;
+    } const guard{*this};
+    p_.finish();
+    return boost::json::value_to<T>(p_.release());
+  }
+
+  void reset() {
+    p_.reset();
+    mr_.release();
+    p_.reset(boost::json::storage_ptr{&mr_});
+  }
+
+  boost::json::monotonic_resource mr_;
+  boost::json::stream_parser p_;
+};
+
+}  // namespace openapi
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+namespace openapi::trace {
+
+#ifdef OPENAPI_TRACE
+constexpr auto const kEnabled = true;
+#else
+constexpr auto const kEnabled = false;
+#endif
+
+// Nanoseconds on the steady clock.
+inline std::int64_t now() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+struct event {
+  char const* name_{nullptr};
+  std::int64_t begin_{0};
+  std::int64_t end_{0};
+};
+
+// Per-thread buffer of the most recent kSize spans.
+// Written only by its thread, so recording needs no synchronization.
+struct ring {
+  static constexpr auto const kSize = std::size_t{1U} << 14U;
+
+  void push(event const& e) noexcept {
+    auto const i = next_.load(std::memory_order_relaxed);
+    events_[i % kSize] = e;
+    next_.store(i + 1U, std::memory_order_release);
+  }
+
+  std::uint32_t tid_{0U};
+  std::atomic<std::uint64_t> next_{0U};
+  std::array<event, kSize> events_{};
+};
+
+// The ring of the calling thread (registered for dumping on first use).
+// When the thread exits, its most recent spans are moved into a buffer of
+// at most ring::kSize retired spans shared by all exited threads, and the
+// ring is freed.
+ring& thread_ring();
+
+// Records the lifetime of the span. Name must be a string literal.
+// Compiles to nothing without OPENAPI_TRACE.
+struct span {
+  explicit span(char const* name) noexcept {
+    if constexpr (kEnabled) {
+      name_ = name;
+      begin_ = now();
+    }
+  }
+
+  ~span() {
+    if constexpr (kEnabled) {
+      thread_ring().push({name_, begin_, now()});
+    }
+  }
+
+  span(span const&) = delete;
+  span& operator=(span const&) = delete;
+
+  char const* name_{nullptr};
+  std::int64_t begin_{0};
+};
+
+// Writes all recorded spans of all threads as Chrome trace event JSON
+// (chrome://tracing, ui.perfetto.dev). Spans recorded concurrently with
+// the dump may be missing or torn: dump while the threads are idle.
+void write_chrome_trace(std::ostream&);
+
+// Drops all recorded spans.
+void clear();
+
+}  // namespace openapi::trace
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iosfwd>
+#include <string_view>
+
+namespace openapi {
+
+// RFC 9562 UUID (format: uuid) stored as its 16 bytes in network order.
+// Ordering matches the order of the canonical string form.
+struct uuid {
+  friend std::ostream& operator<<(std::ostream&, uuid const&);
+
+  std::size_t hash() const {
+    auto a = std::uint64_t{};
+    auto b = std::uint64_t{};
+    std::memcpy(&a, bytes_.data(), sizeof(a));
+    std::memcpy(&b, bytes_.data() + sizeof(a), sizeof(b));
+    return static_cast<std::size_t>(a ^ (b * 0x9E3779B97F4A7C15ULL));
+  }
+
+  auto operator<=>(uuid const&) const = default;
+
+  std::array<std::uint8_t, 16U> bytes_{};
+};
+
+using uuid_buf_t = std::array<char, 36U>;
+
+// Canonical lowercase 8-4-4-4-12 form.
+std::string_view format(uuid const&, uuid_buf_t&);
+
+// Accepts the 8-4-4-4-12 form in either case.
+void parse(std::string_view, uuid&);
+
+}  // namespace openapi
+
+template <>
+struct std::hash<openapi::uuid> {
+  std::size_t operator()(openapi::uuid const& u) const { return u.hash(); }
+};
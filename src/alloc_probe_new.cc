@@ -0,0 +1,40 @@
+// Replaces the global operator new to feed openapi::thread_allocs.
+// Not part of the openapi library: link openapi-alloc-probe explicitly.
+
+#include <cstdlib>
+#include <new>
+
+#include "openapi/alloc_probe.h"
+
+namespace {
+
+void* count(void* const ptr, std::size_t const size) {
+  if (ptr == nullptr) {
+    throw std::bad_alloc{};
+  }
+  ++openapi::thread_allocs.count_;
+  openapi::thread_allocs.bytes_ += size;
+  return ptr;
+}
+
+}  // namespace
+
+void* operator new(std::size_t const size) {
+  return count(std::malloc(size == 0U ? 1U : size), size);
+}
+
+void* operator new(std::size_t const size, std::align_val_t const align) {
+  auto const a = static_cast<std::size_t>(align);
+  auto const n = (size == 0U ? 1U : size + a - 1U) / a * a;
+  return count(std::aligned_alloc(a, n == 0U ? a : n), size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
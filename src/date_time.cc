@@ -1,20 +1,67 @@
 #include "openapi/date_time.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <ostream>
 
-#include "utl/verify.h"
+#include "fmt/format.h"
 
-#include "date/date.h"
-#include "date/tz.h"
+#include "utl/verify.h"
 
 namespace openapi {
 
+namespace {
+
+bool parse_digits(std::string_view s,
+                  std::size_t const pos,
+                  std::size_t const n,
+                  int& out) {
+  if (pos + n > s.size()) {
+    return false;
+  }
+  out = 0;
+  for (auto i = pos; i != pos + n; ++i) {
+    if (s[i] < '0' || s[i] > '9') {
+      return false;
+    }
+    out = out * 10 + (s[i] - '0');
+  }
+  return true;
+}
+
+}  // namespace
+
 std::optional<date_time_t> now_test = std::nullopt;
 
+std::string_view format(date_time_t const& t, date_time_buf_t& buf) {
+  using namespace std::chrono;
+
+  auto const local = t.time_ + t.offset_;
+  auto const day = floor<days>(local);
+  auto const ymd = year_month_day{day};
+  auto const time = hh_mm_ss{local - day};
+
+  auto out = fmt::format_to_n(
+      buf.data(), buf.size(), "{:04}-{:02}-{:02}T{:02}:{:02}:{:02}",
+      static_cast<int>(ymd.year()), static_cast<unsigned>(ymd.month()),
+      static_cast<unsigned>(ymd.day()), time.hours().count(),
+      time.minutes().count(), time.seconds().count());
+
+  auto const offset = t.offset_.count();
+  if (offset == 0) {
+    out = fmt::format_to_n(out.out, buf.size() - out.size, "Z");
+  } else {
+    out = fmt::format_to_n(out.out, buf.size() - out.size, "{}{:02}:{:02}",
+                           offset < 0 ? '-' : '+', std::abs(offset) / 60,
+                           std::abs(offset) % 60);
+  }
+  return {buf.data(), out.out};
+}
+
 std::ostream& operator<<(std::ostream& out, date_time_t const& t) {
   utl::verify(t.offset_ == std::chrono::minutes{0}, "offset not supported yet");
-  out << date::format("%FT%TZ", t.time_);
-  return out;
+  auto buf = date_time_buf_t{};
+  return out << format(t, buf);
 }
 
 date_time_t now() {
@@ -25,43 +72,94 @@ date_time_t now() {
       std::chrono::system_clock::now());
 }
 
+// Accepts YYYY-MM-DDTHH:MM[:SS[.fraction]] followed by Z or +HH:MM / -HH:MM.
 void parse(std::string_view s, date_time_t& v) {
-  auto in = std::istringstream{std::string{s}};
+  using namespace std::chrono;
 
-  auto tp = date::sys_time<std::chrono::milliseconds>{};
-  in >> date::parse("%FT%TZ", tp);
+  auto const is = [&](std::size_t const i, char const c) {
+    return i < s.size() && s[i] == c;
+  };
 
-  if (!in.fail()) {
-    v = tp;
-    return;
-  }
+  auto y = 0, mon = 0, d = 0, h = 0, min = 0, sec = 0, ms = 0;
+  auto ok = parse_digits(s, 0U, 4U, y) && is(4U, '-') &&
+            parse_digits(s, 5U, 2U, mon) && is(7U, '-') &&
+            parse_digits(s, 8U, 2U, d) && is(10U, 'T') &&
+            parse_digits(s, 11U, 2U, h) && is(13U, ':') &&
+            parse_digits(s, 14U, 2U, min);
 
-  auto offset = std::chrono::minutes{};
-  in.clear();
-  in.str(std::string{s});
-  in >> date::parse("%FT%T%Ez", tp, offset);
-  if (!in.fail()) {
-    v = {tp, offset};
-    return;
+  auto pos = std::size_t{16U};
+  if (ok && is(pos, ':')) {
+    ok = parse_digits(s, pos + 1U, 2U, sec);
+    pos += 3U;
+    if (ok && is(pos, '.')) {
+      ++pos;
+      auto const begin = pos;
+      for (; pos < s.size() && s[pos] >= '0' && s[pos] <= '9'; ++pos) {
+        if (pos - begin < 3U) {
+          ms = ms * 10 + (s[pos] - '0');
+        }
+      }
+      ok = pos != begin;
+      for (auto i = std::min(pos - begin, std::size_t{3U}); i < 3U; ++i) {
+        ms *= 10;
+      }
+    }
   }
 
-  in.clear();
-  in.str(std::string{s});
-  in >> date::parse("%FT%H:%MZ", tp);
-  if (!in.fail()) {
-    v = tp;
-    return;
+  auto offset = 0;
+  if (ok && is(pos, 'Z')) {
+    ok = pos + 1U == s.size();
+  } else if (ok && (is(pos, '+') || is(pos, '-'))) {
+    auto oh = 0, om = 0;
+    auto const colon = is(pos + 3U, ':');
+    ok = parse_digits(s, pos + 1U, 2U, oh) &&
+         parse_digits(s, pos + (colon ? 4U : 3U), 2U, om) &&
+         pos + (colon ? 6U : 5U) == s.size();
+    offset = (s[pos] == '-' ? -1 : 1) * (oh * 60 + om);
+  } else {
+    ok = false;
   }
 
-  in.clear();
-  in.str(std::string{s});
-  in >> date::parse("%FT%H:%M%Ez", tp, offset);
-  if (!in.fail()) {
-    v = {tp, offset};
-    return;
+  auto const date = year{y} / month{static_cast<unsigned>(mon)} /
+                    day{static_cast<unsigned>(d)};
+  if (!ok || !date.ok() || h > 23 || min > 59 || sec > 60) {
+    throw utl::fail("failed to parse timestamp \"{}\"", s);
   }
 
-  throw utl::fail("failed to parse timestamp \"{}\"", s);
+  auto const tp = sys_days{date} + hours{h} + minutes{min} + seconds{sec} +
+                  milliseconds{ms} - minutes{offset};
+  v = offset == 0 ? date_time_t{tp} : date_time_t{tp, minutes{offset}};
+}
+
+std::string_view format(date_t const& d, date_buf_t& buf) {
+  using namespace std::chrono;
+
+  auto const ymd = year_month_day{sys_days{d}};
+  auto const out = fmt::format_to_n(buf.data(), buf.size(), "{:04}-{:02}-{:02}",
+                                    static_cast<int>(ymd.year()),
+                                    static_cast<unsigned>(ymd.month()),
+                                    static_cast<unsigned>(ymd.day()));
+  return {buf.data(), out.out};
+}
+
+std::ostream& operator<<(std::ostream& out, date_t const& d) {
+  auto buf = date_buf_t{};
+  return out << format(d, buf);
+}
+
+void parse(std::string_view s, date_t& v) {
+  using namespace std::chrono;
+
+  auto y = 0, mon = 0, d = 0;
+  auto const ok = s.size() == 10U && parse_digits(s, 0U, 4U, y) &&
+                  s[4] == '-' && parse_digits(s, 5U, 2U, mon) &&
+                  s[7] == '-' && parse_digits(s, 8U, 2U, d);
+  auto const date = year{y} / month{static_cast<unsigned>(mon)} /
+                    day{static_cast<unsigned>(d)};
+  if (!ok || !date.ok()) {
+    throw utl::fail("failed to parse date \"{}\"", s);
+  }
+  v = date;
 }
 
-}  // namespace openapi
\ No newline at end of file
+}  // namespace openapi
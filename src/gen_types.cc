@@ -1,29 +1,76 @@
 #include "openapi/gen_types.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
 #include <optional>
 #include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "utl/enumerate.h"
+
+#include "openapi/date_time.h"
+#include "openapi/polyline.h"
+#include "openapi/router.h"
+#include "openapi/uuid.h"
 
 namespace openapi {
 
 void write_prelude(std::string_view path_to_header,
+                   std::vector<std::string> const& includes,
                    std::ostream& header,
                    std::ostream& source,
                    std::optional<std::string_view> ns) {
   header << R"(#pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <optional>
+#include <ranges>
+#include <span>
 #include <string_view>
 #include <map>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include "boost/url.hpp"
 #include "boost/json/fwd.hpp"
 
 #include "openapi/date_time.h"
+#include "openapi/enum_set.h"
+#include "openapi/fields.h"
+#include "openapi/fixed_point.h"
+#include "openapi/flat_map.h"
+#include "openapi/lazy.h"
+#include "openapi/metrics.h"
+#include "openapi/polyline.h"
+#include "openapi/presence.h"
+#include "openapi/router.h"
+#include "openapi/rows.h"
+#include "openapi/serialized_size.h"
+#include "openapi/stream.h"
+#include "openapi/stream_decoder.h"
+#include "openapi/uuid.h"
 )";
+  if (!includes.empty()) {
+    header << "\n";
+    for (auto const& i : includes) {
+      header << "#include \"" << i << "\"\n";
+    }
+  }
 
   source << R"(#include ")" << path_to_header << "\"\n";
   source << R"(
+#include <array>
+
 #include "cista/hash.h"
 
 #include "boost/json.hpp"
@@ -33,23 +80,6 @@ void write_prelude(std::string_view path_to_header,
 #include "openapi/json.h"
 #include "openapi/parse.h"
 
-namespace std {
-
-template <typename T>
-std::ostream& operator<<(std::ostream& out, std::vector<T> const& v) {
-  auto first = true;
-  for (auto const& x : v) {
-    if (!first) {
-      out << ",";
-    }
-    first = false;
-    out << x;
-  }
-  return out;
-}
-
-}  // namespace std
-
 )";
 
   if (ns.has_value()) {
@@ -81,6 +111,12 @@ type to_type(YAML::Node const& schema) {
         return type::kString;
       } else if (format == "date-time") {
         return type::kDate;
+      } else if (format == "date") {
+        return type::kFullDate;
+      } else if (format == "polyline") {
+        return type::kPolyline;
+      } else if (format == "uuid") {
+        return type::kUuid;
       } else {
         throw utl::fail("unknown format {}", format);
       }
@@ -100,6 +136,9 @@ std::string_view to_cpp(type const t) {
     case type::kBoolean: return "bool";
     case type::kArray: return "std::vector";
     case type::kObject: return "std::map<std::string, std::uint64_t>";
+    case type::kPolyline: return "openapi::polyline<5U>";
+    case type::kUuid: return "openapi::uuid";
+    case type::kFullDate: return "openapi::date_t";
     default: std::unreachable();
   }
 }
@@ -146,16 +185,31 @@ bool gen_enum(std::string_view type_name,
         header << e;
       }
       header << "\n};\n\n";
+      header << "using " << name << "Set = openapi::enum_set<" << name << ", "
+             << enumera.size() << "U>;\n\n";
     }
 
     {
-      header << name << " tag_invoke(boost::json::value_to_tag<" << name
-             << ">, boost::json::value const&);\n";
+      header << "std::string_view to_str(" << name << ");\n";
+      source << "std::string_view to_str(" << name
+             << " const v) {\n"
+                "  switch (v) {";
+      auto ind = indent{2, 0};
+      for (auto const& e : enumera) {
+        ind(source);
+        source << "case " << name << "::" << e << ": return \"" << e
+               << "\";";
+      }
+      ind(source);
+      source << "}\n";
+      source << "  throw utl::fail(\"invalid " << name
+             << " value {}\", static_cast<int>(v));\n"
+             << "}\n\n";
+    }
 
-      source << name << " tag_invoke(boost::json::value_to_tag<" << name
-             << ">, boost::json::value const& jv) {\n";
-      source << "  auto x = " << name << "{};\n";
-      source << "  auto const sv = std::string_view{jv.as_string()};\n";
+    {
+      header << "void parse(std::string_view, " << name << "&);\n";
+      source << "void parse(std::string_view sv, " << name << "& x) {\n";
       source << "  switch (cista::hash(sv)) {";
       auto ind = indent{2, 0};
       for (auto const& e : enumera) {
@@ -167,6 +221,17 @@ bool gen_enum(std::string_view type_name,
       source << "default: throw utl::fail(\"enum " << name
              << ": unknown value {}\", sv);\n";
       source << "  }\n";
+      source << "}\n\n";
+    }
+
+    {
+      header << name << " tag_invoke(boost::json::value_to_tag<" << name
+             << ">, boost::json::value const&);\n";
+
+      source << name << " tag_invoke(boost::json::value_to_tag<" << name
+             << ">, boost::json::value const& jv) {\n";
+      source << "  auto x = " << name << "{};\n";
+      source << "  parse(jv.as_string(), x);\n";
       source << "  return x;\n";
       source << "}\n\n";
     }
@@ -179,20 +244,26 @@ bool gen_enum(std::string_view type_name,
 
       source << "std::ostream& operator<<(std::ostream& out, " << name
              << " x) {\n"
-             << "  return out << "
-                "static_cast<std::string_view>(boost::json::value_from(x).as_"
-                "string());\n"
+             << "  return out << to_str(x);\n"
              << "}\n\n";
       source << "void tag_invoke(boost::json::value_from_tag, "
                 "boost::json::value& jv, "
              << name
+             << " const v) {\n"
+                "  jv = to_str(v);\n"
+                "}\n\n";
+    }
+
+    {
+      header << "std::size_t serialized_size(" << name << ");\n\n";
+      source << "std::size_t serialized_size(" << name
              << " const v) {\n"
                 "  switch (v) {";
       auto ind = indent{2, 0};
       for (auto const& e : enumera) {
         ind(source);
-        source << "case " << name << "::" << e << ": jv = \"" << e
-               << "\"; return;";
+        source << "case " << name << "::" << e
+               << ": return " << e.as<std::string_view>().size() + 2U << "U;";
       }
       ind(source);
       source << "}\n";
@@ -205,6 +276,11 @@ bool gen_enum(std::string_view type_name,
   return false;
 }
 
+bool has_extension(YAML::Node const& schema, std::string_view key) {
+  auto const x = schema[key];
+  return x.IsDefined() && x.as<bool>();
+}
+
 std::string_view ref_name(YAML::Node const& ref) {
   auto const prefix = std::string_view{"#/components/schemas/"};
   auto const type = ref.as<std::string_view>().substr(prefix.size());
@@ -217,6 +293,178 @@ YAML::Node resolve_schema(YAML::Node const& root, YAML::Node const& schema) {
                          : schema;
 }
 
+// Merges the properties and required lists of all allOf parts (in order,
+// later parts override earlier ones) into one object schema. Extensions of
+// the composed schema itself are kept.
+YAML::Node flatten_all_of(YAML::Node const& root, YAML::Node const& schema) {
+  auto properties = YAML::Node{YAML::NodeType::Map};
+  auto required = YAML::Node{YAML::NodeType::Sequence};
+  auto const add = [&](auto&& self, YAML::Node const& part) -> void {
+    auto const s = resolve_schema(root, part);
+    for (auto const& p : s["allOf"]) {
+      self(self, p);
+    }
+    for (auto const& p : s["properties"]) {
+      properties[p.first.as<std::string>()] = p.second;
+    }
+    for (auto const& r : s["required"]) {
+      auto known = false;
+      for (auto const& x : required) {
+        known |= x.as<std::string_view>() == r.as<std::string_view>();
+      }
+      if (!known) {
+        required.push_back(r);
+      }
+    }
+  };
+  add(add, schema);
+
+  auto merged = YAML::Node{YAML::NodeType::Map};
+  for (auto const& x : schema) {
+    if (x.first.as<std::string_view>().starts_with("x-")) {
+      merged[x.first.as<std::string>()] = x.second;
+    }
+  }
+  merged["type"] = "object";
+  merged["properties"] = properties;
+  merged["required"] = required;
+  return merged;
+}
+
+// Resolves $refs and allOf compositions to the effective object schema.
+YAML::Node resolve_object(YAML::Node const& root, YAML::Node const& schema) {
+  auto const s = resolve_schema(root, schema);
+  return s["allOf"].IsDefined() ? flatten_all_of(root, s) : s;
+}
+
+bool is_flat_map(YAML::Node const& schema) {
+  auto const additional = schema["additionalProperties"];
+  return additional.IsDefined() && additional.IsMap();
+}
+
+std::optional<unsigned> get_precision(YAML::Node const& schema) {
+  auto const precision = schema["x-precision"];
+  if (!precision.IsDefined()) {
+    return std::nullopt;
+  }
+  auto const n = precision.as<unsigned>();
+  utl::verify(n <= 9U, "x-precision {} exceeds 9 digits", n);
+  return n;
+}
+
+// Enum arrays with uniqueItems (or x-enum-set) become bitsets.
+bool is_enum_set(YAML::Node const& root, YAML::Node const& schema) {
+  auto const items = schema["items"];
+  auto const unique = schema["uniqueItems"];
+  return items.IsDefined() &&
+         ((unique.IsDefined() && unique.as<bool>()) ||
+          has_extension(schema, "x-enum-set")) &&
+         resolve_schema(root, items)["enum"].IsDefined();
+}
+
+// Numbers with x-precision are stored as scaled integers, numbers with
+// format: float as float.
+std::string number_type(YAML::Node const& schema) {
+  auto const precision = get_precision(schema);
+  auto const format = schema["format"];
+  return precision.has_value()
+             ? fmt::format("openapi::fixed_point<{}U>", *precision)
+         : format.IsDefined() && format.as<std::string_view>() == "float"
+             ? "float"
+             : std::string{to_cpp(type::kNumber)};
+}
+
+// Integers take the narrowest type holding [minimum, maximum]. Without both
+// bounds, format: int32 selects std::int32_t.
+std::string integer_type(YAML::Node const& schema) {
+  auto const min = schema["minimum"];
+  auto const max = schema["maximum"];
+  if (min.IsDefined() && max.IsDefined()) {
+    auto const lo = min.as<std::int64_t>();
+    if (lo >= 0) {
+      auto const hi = max.as<std::uint64_t>();
+      auto const fits = [&]<typename T>(T) {
+        return hi <= std::numeric_limits<T>::max();
+      };
+      return fits(std::uint8_t{})    ? "std::uint8_t"
+             : fits(std::uint16_t{}) ? "std::uint16_t"
+             : fits(std::uint32_t{}) ? "std::uint32_t"
+                                     : "std::uint64_t";
+    }
+    auto const hi = max.as<std::int64_t>();
+    auto const fits = [&]<typename T>(T) {
+      return lo >= std::numeric_limits<T>::min() &&
+             hi <= std::numeric_limits<T>::max();
+    };
+    return fits(std::int8_t{})    ? "std::int8_t"
+           : fits(std::int16_t{}) ? "std::int16_t"
+           : fits(std::int32_t{}) ? "std::int32_t"
+                                  : "std::int64_t";
+  }
+  auto const format = schema["format"];
+  return format.IsDefined() && format.as<std::string_view>() == "int32"
+             ? "std::int32_t"
+             : std::string{to_cpp(type::kInteger)};
+}
+
+// Template arguments of openapi::check_range for numbers with minimum or
+// maximum, checked when decoding and after patching.
+std::optional<std::string> get_range_args(YAML::Node const& root,
+                                          YAML::Node const& schema) {
+  auto const s = resolve_schema(root, schema);
+  if (!s["type"].IsDefined() || s["x-cpp-type"].IsDefined() ||
+      s["x-precision"].IsDefined() ||
+      (to_type(s) != type::kInteger && to_type(s) != type::kNumber)) {
+    return std::nullopt;
+  }
+  auto const min = s["minimum"];
+  auto const max = s["maximum"];
+  if (!min.IsDefined() && !max.IsDefined()) {
+    return std::nullopt;
+  }
+  auto const bound = [](YAML::Node const& n) {
+    return n.IsDefined() ? n.as<std::string>()
+                         : std::string{"openapi::no_bound{}"};
+  };
+  return fmt::format("<{}, {}>", bound(min), bound(max));
+}
+
+// Encoded polylines use five fraction digits unless x-precision is set.
+std::string polyline_type(YAML::Node const& schema) {
+  return fmt::format("openapi::polyline<{}U>",
+                     get_precision(schema).value_or(5U));
+}
+
+// Arrays of plain numeric arrays are stored in one contiguous buffer:
+// fixed_rows if minItems == maxItems, ragged_rows otherwise.
+std::optional<std::string> get_rows_type(YAML::Node const& schema) {
+  auto const row = schema["items"];
+  if (!row.IsDefined() || !row["type"].IsDefined() ||
+      to_type(row) != type::kArray) {
+    return std::nullopt;
+  }
+  auto const value = row["items"];
+  if (!value.IsDefined() || !value["type"].IsDefined() ||
+      value["enum"].IsDefined() || value["x-cpp-type"].IsDefined()) {
+    return std::nullopt;
+  }
+  auto const t = to_type(value);
+  if (t != type::kInteger && t != type::kNumber) {
+    return std::nullopt;
+  }
+  auto const value_type =
+      t == type::kNumber ? number_type(value) : integer_type(value);
+  auto const min = row["minItems"];
+  auto const max = row["maxItems"];
+  if (min.IsDefined() && max.IsDefined() &&
+      min.as<std::size_t>() == max.as<std::size_t>() &&
+      min.as<std::size_t>() != 0U) {
+    return fmt::format("openapi::fixed_rows<{}, {}>", value_type,
+                       min.as<std::size_t>());
+  }
+  return fmt::format("openapi::ragged_rows<{}>", value_type);
+}
+
 std::string get_type(YAML::Node const& root,
                      std::string_view name,
                      YAML::Node const& schema,
@@ -231,12 +479,43 @@ std::string get_type(YAML::Node const& root,
                                    : std::string{"std::optional<"} + x + ">";
   }
 
+  if (auto const cpp_type = schema["x-cpp-type"]; cpp_type.IsDefined()) {
+    auto const x = cpp_type.as<std::string>();
+    return required || schema["default"].IsDefined()
+               ? x
+               : std::string{"std::optional<"} + x + ">";
+  }
+
   auto const type = to_type(schema);
   auto const enumera = schema["enum"];
-  auto const t = std::string{enumera.IsDefined() ? std::string{name} + "Enum"
-                                                 : to_cpp(type)};
-  auto const items = schema["items"];
   auto const has_default = schema["default"].IsDefined();
+  if (type == type::kObject && is_flat_map(schema)) {
+    auto const x = std::string{"openapi::flat_map<"} +
+                   get_type(root, name, schema["additionalProperties"]) + '>';
+    return required || has_default ? x
+                                   : std::string{"std::optional<"} + x + ">";
+  }
+
+  if (type == type::kArray && is_enum_set(root, schema)) {
+    auto const x = get_type(root, name, schema["items"]) + "Set";
+    return required || has_default ? x
+                                   : std::string{"std::optional<"} + x + ">";
+  }
+
+  if (type == type::kArray) {
+    if (auto const rows = get_rows_type(schema); rows.has_value()) {
+      return required || has_default ? *rows
+                                     : std::string{"std::optional<"} + *rows +
+                                           ">";
+    }
+  }
+
+  auto const t = enumera.IsDefined()     ? std::string{name} + "Enum"
+                 : type == type::kNumber   ? number_type(schema)
+                 : type == type::kInteger  ? integer_type(schema)
+                 : type == type::kPolyline ? polyline_type(schema)
+                                           : std::string{to_cpp(type)};
+  auto const items = schema["items"];
   auto const x =
       items.IsDefined() ? t + '<' + get_type(root, name, items) + '>' : t;
   return required || has_default ? x : std::string{"std::optional<"} + x + ">";
@@ -247,6 +526,132 @@ bool is_required(YAML::Node const& n) {
   return required.IsDefined() && required.as<bool>();
 }
 
+// Headers named by x-cpp-include anywhere in the spec, in order of
+// appearance. Values can be a single header or a list.
+std::vector<std::string> get_includes(YAML::Node const& root) {
+  auto includes = std::vector<std::string>{};
+  auto const add = [&](std::string i) {
+    if (std::ranges::find(includes, i) == end(includes)) {
+      includes.push_back(std::move(i));
+    }
+  };
+  auto const collect = [&](auto&& self, YAML::Node const& n) -> void {
+    if (n.IsSequence()) {
+      for (auto const& x : n) {
+        self(self, x);
+      }
+    } else if (n.IsMap()) {
+      for (auto const& x : n) {
+        if (x.first.as<std::string_view>() != "x-cpp-include") {
+          self(self, x.second);
+        } else if (x.second.IsSequence()) {
+          for (auto const& i : x.second) {
+            add(i.as<std::string>());
+          }
+        } else {
+          add(x.second.as<std::string>());
+        }
+      }
+    }
+  };
+  collect(collect, root);
+  return includes;
+}
+
+// Trailing codec argument of the openapi:: member helpers for members with
+// an x-cpp-codec (on the property or on the referenced schema).
+std::string codec_arg(YAML::Node const& root, YAML::Node const& schema) {
+  auto const own = schema["x-cpp-codec"];
+  auto const codec =
+      own.IsDefined() ? own : resolve_schema(root, schema)["x-cpp-codec"];
+  return codec.IsDefined() ? ", " + codec.as<std::string>() + "{}"
+                           : std::string{};
+}
+
+bool is_path_param(YAML::Node const& p) {
+  auto const in = p["in"];
+  return in.IsDefined() && in.as<std::string_view>() == "path";
+}
+
+// Returns the parameter name of a "{name}" path template segment.
+std::optional<std::string_view> path_param_name(std::string_view const seg) {
+  if (seg.starts_with('{') && seg.ends_with('}')) {
+    return seg.substr(1U, seg.size() - 2U);
+  }
+  utl::verify(seg.find_first_of("{}") == std::string_view::npos,
+              "unsupported path segment {}", seg);
+  return std::nullopt;
+}
+
+std::vector<std::string_view> get_path_params(std::string_view path) {
+  auto params = std::vector<std::string_view>{};
+  auto seg = std::string_view{};
+  while (next_segment(path, seg)) {
+    if (auto const name = path_param_name(seg); name.has_value()) {
+      params.push_back(*name);
+    }
+  }
+  return params;
+}
+
+// Literal parts of a path template around its parameters:
+// "/items/{id}/tags/{tag}" yields "/items/", "/tags/" and "".
+std::vector<std::string_view> get_path_literals(std::string_view path) {
+  auto literals = std::vector<std::string_view>{};
+  auto pos = std::size_t{0U};
+  for (auto open = path.find('{'); open != std::string_view::npos;
+       open = path.find('{', pos)) {
+    literals.push_back(path.substr(pos, open - pos));
+    pos = path.find('}', open);
+    utl::verify(pos != std::string_view::npos,
+                "unterminated path parameter in {}", path);
+    ++pos;
+  }
+  literals.push_back(path.substr(pos));
+  return literals;
+}
+
+std::string cpp_string_literal(std::string_view s) {
+  auto out = std::string{"\""};
+  for (auto const c : s) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      default: out += c;
+    }
+  }
+  return out + '"';
+}
+
+// Parses a string default with a format when generating, so an invalid
+// literal fails here and not in every constructor of the generated type.
+void verify_default(std::string_view name, type const t, std::string const& s) {
+  try {
+    switch (t) {
+      case type::kDate: {
+        auto x = date_time_t{};
+        parse(s, x);
+      } break;
+      case type::kFullDate: {
+        auto x = date_t{};
+        parse(s, x);
+      } break;
+      case type::kUuid: {
+        auto x = uuid{};
+        parse(s, x);
+      } break;
+      case type::kPolyline: {
+        auto x = polyline<5U>{};
+        decode_polyline(s, x);
+      } break;
+      default: break;
+    }
+  } catch (std::exception const& e) {
+    throw utl::fail("{}: invalid default {}: {}", name, s, e.what());
+  }
+}
+
 void gen_value(YAML::Node const& root,
                std::string_view name,
                YAML::Node const& schema,
@@ -258,6 +663,9 @@ void gen_value(YAML::Node const& root,
     return;
   }
 
+  utl::verify(!schema["x-cpp-type"].IsDefined(),
+              "{}: default not supported with x-cpp-type", name);
+
   auto const type = to_type(schema);
   auto const enumera = schema["enum"];
   if (enumera) {
@@ -275,7 +683,20 @@ void gen_value(YAML::Node const& root,
       }
       out << "}";
     } break;
-    case type::kString: out << '"' << default_value << '"'; break;
+    case type::kString:
+      out << cpp_string_literal(default_value.as<std::string>());
+      break;
+    case type::kDate:
+    case type::kFullDate:
+    case type::kUuid:
+    case type::kPolyline: {
+      auto const s = default_value.as<std::string>();
+      verify_default(name, type, s);
+      out << "[] { auto x = " << get_type(root, name, schema)
+          << "{}; ::openapi::"
+          << (type == type::kPolyline ? "decode_polyline" : "parse") << "("
+          << cpp_string_literal(s) << ", x); return x; }()";
+    } break;
     default: out << default_value;
   }
 }
@@ -300,17 +721,32 @@ void gen_member_init(YAML::Node const& root,
   auto const schema = x["schema"];
   auto const name = x["name"].as<std::string_view>();
   auto const type = get_type(root, name, schema, is_required);
-  out << "  " << name << "_{::openapi::parse_param<" << type << ">(params, \""
-      << name << "\"";
-  auto const default_value = schema["default"];
-  if (default_value.IsDefined()) {
-    out << ", ";
-    gen_value(root, name, schema, default_value, out);
+  auto const range = get_range_args(root, schema);
+  out << "  " << name << "_{";
+  if (range.has_value()) {
+    out << "::openapi::check_range" << *range << "(";
+  }
+  if (is_path_param(x)) {
+    out << "::openapi::parse_path_param<" << type << ">(path." << name
+        << "_, \"" << name << "\")";
+  } else {
+    out << "::openapi::parse_param<" << type << ">(params, \"" << name
+        << "\"";
+    auto const default_value = schema["default"];
+    if (default_value.IsDefined()) {
+      out << ", ";
+      gen_value(root, name, schema, default_value, out);
+    }
+    out << ")";
+  }
+  if (range.has_value()) {
+    out << ", \"" << name << "\")";
   }
-  out << ")}";
+  out << "}";
 }
 
 void write_params(YAML::Node const& root,
+                  std::string_view path,
                   YAML::Node const& n,
                   std::ostream& header,
                   std::ostream& source) {
@@ -324,17 +760,40 @@ void write_params(YAML::Node const& root,
     }
   }
 
-  auto const id = n["operationId"].as<std::string>() + "_params";
+  auto const op = n["operationId"].as<std::string>();
+  auto const id = op + "_params";
+  auto const path_id = op + "_path";
+
+  auto const parameters = n["parameters"];
+  auto has_path_params = false;
+  for (auto const& p : parameters) {
+    has_path_params |= is_path_param(p);
+  }
 
   header << "struct " << id << " {\n";
   header << "  explicit " << id << "();\n";
-  header << "  explicit " << id << "(boost::urls::params_view const&);\n";
+  // Operations with path parameters need the matched path segments.
+  header << "  explicit " << id << "(boost::urls::params_view const&, "
+         << path_id << " const&" << (has_path_params ? "" : " = {}")
+         << ");\n";
   header << "  boost::urls::url to_url(std::string_view path) const;\n";
 
   source << id << "::" << id << "() = default;\n";
-  source << id << "::" << id << "(boost::urls::params_view const& params)";
+  source << fmt::format(R"(
+{0}::{0}(boost::urls::params_view const& params, {2} const& path) try
+    : {0}{{params, path,
+          openapi::scoped_timer{{{1}_metrics.params_parse_ns_,
+                                "{1}.params_parse"}}}} {{
+}} catch (...) {{
+  {1}_metrics.count_error();
+}}
+
+)",
+                        id, op, path_id);
+  source << id << "::" << id << "(boost::urls::params_view const& params, "
+         << path_id << " const&" << (has_path_params ? " path" : "")
+         << ", openapi::scoped_timer&&)";
 
-  auto const parameters = n["parameters"];
   if (parameters.IsDefined() && parameters.size() != 0) {
     source << " :";
     auto ind = indent{2};
@@ -345,55 +804,138 @@ void write_params(YAML::Node const& root,
   }
   source << "\n  {}\n\n";
 
-  if (parameters.IsDefined() && parameters.size() != 0) {
-    source << "boost::urls::url " << id
-           << "::to_url(std::string_view path) const {\n";
-    source << "  auto u = boost::urls::url{path};\n";
-    source << "  auto default_val = " << id << "{};\n";
-    for (auto const& p : parameters) {
+  auto query_params = std::vector<YAML::Node>{};
+  for (auto const& p : parameters) {
+    if (!is_path_param(p)) {
+      query_params.push_back(p);
+    }
+  }
+
+  // Appends the query parameters that differ from their defaults with
+  // `append_code` (called with indentation and parameter name).
+  auto const gen_query = [&](auto&& append_code) {
+    for (auto const& p : query_params) {
       auto const name = p["name"].as<std::string_view>();
       auto const schema = p["schema"];
       auto const has_default = schema["default"].IsDefined();
       auto const is_optional = !is_required(p) && !has_default;
 
+      auto const in = std::string_view{is_optional ? "      " : "    "};
+
       source << "  if (default_val." << name << "_ != " << name << "_) {\n";
       if (is_optional) {
-        source << "    if (" << name << "_.has_value()) {\n  ";
+        source << "    if (" << name << "_.has_value()) {\n";
       }
-      source << "    u.params().append({\"" << name
-             << "\", fmt::to_string(fmt::streamed(" << (is_optional ? "*" : "")
-             << name << "_))});\n";
+      source << in << "buf.clear();\n"
+             << in << "openapi::format_param(buf, " << (is_optional ? "*" : "")
+             << name << "_);\n";
+      append_code(in, name);
       if (is_optional) {
         source << "    }\n";
       }
       source << "  }\n";
     }
+  };
+
+  if (!query_params.empty()) {
+    source << "boost::urls::url " << id
+           << "::to_url(std::string_view path) const {\n";
+    source << "  static auto const default_val = " << id << "{};\n";
+    source << "  auto u = boost::urls::url{path};\n";
+    source << "  auto buf = fmt::memory_buffer{};\n";
+    gen_query([&](std::string_view in, std::string_view name) {
+      source << in << "u.params().append({\"" << name
+             << "\", std::string_view{buf.data(), buf.size()}});\n";
+    });
     source << "  return u;\n";
-    source << "}\n";
+    source << "}\n\n";
   } else {
     source << "boost::urls::url " << id
            << "::to_url(std::string_view path) const { return "
-              "boost::urls::url{path}; }\n";
+              "boost::urls::url{path}; }\n\n";
+  }
+
+  auto const literals = get_path_literals(path);
+  auto const path_params = get_path_params(path);
+  for (auto const& name : path_params) {
+    auto declared = false;
+    for (auto const& p : parameters) {
+      declared |= is_path_param(p) && p["name"].as<std::string_view>() == name;
+    }
+    utl::verify(declared, "{}: path parameter {} not declared", op, name);
+  }
+
+  header << "  static constexpr auto const kPathLiterals = "
+            "std::array<std::string_view, "
+         << literals.size() << "U>{";
+  for (auto const [i, l] : utl::enumerate(literals)) {
+    header << (i == 0U ? "" : ", ") << '"' << l << '"';
+  }
+  header << "};\n";
+  header << "  // Writes the path with expanded path parameters and the\n"
+            "  // query. Instantiated for fmt::memory_buffer and std::string.\n"
+            "  template <typename Buffer>\n"
+            "  void write_url(Buffer&) const;\n";
+
+  source << "template <typename Buffer>\n"
+         << "void " << id << "::write_url(Buffer& out) const {\n";
+  if (!query_params.empty()) {
+    source << "  static auto const default_val = " << id << "{};\n";
+  }
+  if (!parameters.IsDefined() || parameters.size() == 0) {
+    source << "  openapi::append(out, kPathLiterals[0U]);\n";
+  } else {
+    source << "  auto buf = fmt::memory_buffer{};\n";
+    for (auto const [i, l] : utl::enumerate(literals)) {
+      if (!l.empty()) {
+        source << "  openapi::append(out, kPathLiterals[" << i << "U]);\n";
+      }
+      if (i < path_params.size()) {
+        source << "  buf.clear();\n"
+               << "  openapi::format_param(buf, " << path_params[i] << "_);\n"
+               << "  openapi::pct_encode(out, "
+                  "std::string_view{buf.data(), buf.size()},\n"
+               << "                      openapi::kPathChars);\n";
+      }
+    }
   }
+  if (!query_params.empty()) {
+    source << "  auto sep = '?';\n";
+    gen_query([&](std::string_view in, std::string_view name) {
+      source << in << "out.push_back(sep);\n"
+             << in << "sep = '&';\n"
+             << in << "openapi::append(out, \"" << name << "=\");\n"
+             << in << "openapi::pct_encode(out, "
+             << "std::string_view{buf.data(), buf.size()},\n"
+             << in << "                    openapi::kQueryChars);\n";
+    });
+  }
+  source << "}\n\n"
+         << "template void " << id
+         << "::write_url(fmt::memory_buffer&) const;\n"
+         << "template void " << id << "::write_url(std::string&) const;\n\n";
 
   for (auto const& p : n["parameters"]) {
     auto const name = p["name"].as<std::string_view>();
     gen_member(root, name, is_required(p), p["schema"], header);
   }
+
+  // Parses while the public constructor's timer is running.
+  header << "\nprivate:\n"
+         << "  " << id << "(boost::urls::params_view const&, " << path_id
+         << " const&, openapi::scoped_timer&&);\n";
   header << "};\n\n";
 }
 
-void gen_type(std::string_view name,
-              YAML::Node const& root,
-              YAML::Node const& schema,
-              std::ostream& header,
-              std::ostream& source) {
-  if (schema["$ref"].IsDefined()) {
-    return;
-  }
-
-  auto const type = to_type(schema);
+struct member {
+  std::string_view name_;
+  YAML::Node schema_;
+  bool required_;
+  bool optional_;
+  std::optional<std::size_t> bit_;
+};
 
+std::vector<member> get_members(YAML::Node const& schema) {
   auto const is_in_required_list =
       [&, required = schema["required"]](std::string_view name) {
         if (!required.IsDefined()) {
@@ -407,6 +949,674 @@ void gen_type(std::string_view name,
         return false;
       };
 
+  auto const use_bitmask = has_extension(schema, "x-presence-bitmask");
+  auto n_optional = std::size_t{0U};
+  auto members = std::vector<member>{};
+  for (auto const& p : schema["properties"]) {
+    auto const name = p.first.as<std::string_view>();
+    auto const required = is_in_required_list(name) || is_required(p.second);
+    auto const optional = !required && !p.second["default"].IsDefined();
+    members.push_back(
+        {.name_ = name,
+         .schema_ = p.second,
+         .required_ = required,
+         .optional_ = optional,
+         .bit_ = use_bitmask && optional ? std::optional{n_optional++}
+                                         : std::nullopt});
+  }
+  return members;
+}
+
+std::size_t count_bits(std::vector<member> const& members) {
+  return static_cast<std::size_t>(std::ranges::count_if(
+      members, [](member const& m) { return m.bit_.has_value(); }));
+}
+
+// Bounds checks of the members of x (minimum / maximum).
+void gen_range_checks(YAML::Node const& root,
+                      std::vector<member> const& members,
+                      std::string_view x,
+                      std::string_view indent,
+                      std::ostream& source) {
+  for (auto const& m : members) {
+    auto const range = get_range_args(root, m.schema_);
+    if (!range.has_value()) {
+      continue;
+    }
+    source << indent;
+    if (m.bit_.has_value()) {
+      source << "if (" << x << ".present_.test(" << *m.bit_ << "U)) ";
+    }
+    source << "openapi::check_range" << *range << "(" << x << "." << m.name_
+           << "_, \"" << m.name_ << "\");\n";
+  }
+}
+
+void gen_accessors(YAML::Node const& root,
+                   std::vector<member> const& members,
+                   std::ostream& header) {
+  for (auto const& m : members) {
+    if (!m.bit_.has_value()) {
+      continue;
+    }
+    auto const t = get_type(root, m.name_, m.schema_);
+    header << fmt::format(R"(
+  bool has_{0}() const {{ return present_.test({1}U); }}
+  {2} const& {0}() const {{ return {0}_; }}
+  void set_{0}({2} x) {{
+    {0}_ = std::move(x);
+    present_.set({1}U);
+  }}
+  void reset_{0}() {{
+    {0}_ = {2}{{}};
+    present_.reset({1}U);
+  }}
+)",
+                          m.name_, *m.bit_, t);
+  }
+}
+
+void gen_columns(std::string_view name,
+                 YAML::Node const& root,
+                 std::vector<member> const& members,
+                 std::ostream& header,
+                 std::ostream& source) {
+  if (members.empty()) {
+    return;
+  }
+
+  auto const cols = std::string{name} + "Columns";
+  auto const size_col = members.front().name_;
+
+  header << "struct " << cols << " {\n";
+
+  // ROW PROXY
+  header << "  struct row {\n";
+  for (auto const& m : members) {
+    auto const t = get_type(root, m.name_, m.schema_);
+    if (m.optional_) {
+      header << "    bool has_" << m.name_ << "() const { return c_->"
+             << m.name_ << "_valid_[i_]; }\n";
+    }
+    header << "    std::vector<" << t << ">::const_reference " << m.name_
+           << "() const { return c_->" << m.name_ << "_[i_]; }\n";
+  }
+  header << "    " << name << " get() const;\n\n"
+         << "    " << cols << " const* c_{nullptr};\n"
+         << "    std::size_t i_{0U};\n"
+         << "  };\n\n";
+
+  source << name << " " << cols << "::row::get() const {\n"
+         << "  auto x = " << name << "{};\n";
+  for (auto const& m : members) {
+    if (!m.optional_) {
+      source << "  x." << m.name_ << "_ = c_->" << m.name_ << "_[i_];\n";
+    } else {
+      source << "  if (c_->" << m.name_ << "_valid_[i_]) {\n";
+      if (m.bit_.has_value()) {
+        source << "    x.set_" << m.name_ << "(c_->" << m.name_ << "_[i_]);\n";
+      } else {
+        source << "    x." << m.name_ << "_ = c_->" << m.name_ << "_[i_];\n";
+      }
+      source << "  }\n";
+    }
+  }
+  source << "  return x;\n"
+         << "}\n\n";
+
+  // ITERATOR
+  header << R"(  struct iterator {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = row;
+    using difference_type = std::ptrdiff_t;
+    using reference = row;
+    using pointer = void;
+
+    row operator*() const { return row{c_, i_}; }
+    iterator& operator++() {
+      ++i_;
+      return *this;
+    }
+    iterator operator++(int) {
+      auto const tmp = *this;
+      ++i_;
+      return tmp;
+    }
+    bool operator==(iterator const&) const = default;
+
+)";
+  header << "    " << cols << " const* c_{nullptr};\n"
+         << "    std::size_t i_{0U};\n"
+         << "  };\n\n";
+
+  header << "  std::size_t size() const { return " << size_col
+         << "_.size(); }\n"
+         << "  bool empty() const { return " << size_col << "_.empty(); }\n"
+         << "  row operator[](std::size_t const i) const {\n"
+            "    return row{this, i};\n"
+            "  }\n"
+         << "  iterator begin() const { return iterator{this, 0U}; }\n"
+         << "  iterator end() const { return iterator{this, size()}; }\n"
+         << "  bool operator==(" << cols << " const&) const = default;\n\n";
+
+  // RESERVE / PUSH_BACK
+  header << "  void reserve(std::size_t);\n";
+  source << "void " << cols << "::reserve(std::size_t const n) {\n";
+  for (auto const& m : members) {
+    source << "  " << m.name_ << "_.reserve(n);\n";
+    if (m.optional_) {
+      source << "  " << m.name_ << "_valid_.reserve(n);\n";
+    }
+  }
+  source << "}\n\n";
+
+  header << "  void push_back(" << name << " const&);\n\n";
+  source << "void " << cols << "::push_back(" << name << " const& x) {\n";
+  for (auto const& m : members) {
+    if (!m.optional_) {
+      source << "  " << m.name_ << "_.push_back(x." << m.name_ << "_);\n";
+    } else if (m.bit_.has_value()) {
+      source << "  " << m.name_ << "_valid_.push_back(x.has_" << m.name_
+             << "());\n"
+             << "  " << m.name_ << "_.push_back(x." << m.name_ << "_);\n";
+    } else {
+      source << "  " << m.name_ << "_valid_.push_back(x." << m.name_
+             << "_.has_value());\n"
+             << "  " << m.name_ << "_.push_back(x." << m.name_
+             << "_.value_or(" << get_type(root, m.name_, m.schema_)
+             << "{}));\n";
+    }
+  }
+  source << "}\n\n";
+
+  // JSON -> COLUMNS
+  header << "  friend " << cols << " tag_invoke(boost::json::value_to_tag<"
+         << cols << ">, boost::json::value const&);\n";
+  source << cols << " tag_invoke(boost::json::value_to_tag<" << cols
+         << ">, boost::json::value const& jv) {\n"
+         << "  auto const& arr = jv.as_array();\n"
+         << "  auto c = " << cols << "{};\n"
+         << "  c.reserve(arr.size());\n"
+         << "  for (auto const& e : arr) {\n"
+         << "    auto const& o = e.as_object();\n";
+  for (auto const& m : members) {
+    utl::verify(codec_arg(root, m.schema_).empty(),
+                "{}: x-columns does not support x-cpp-codec member {}", name,
+                m.name_);
+    source << "    openapi::extract_column(o, c." << m.name_ << "_, ";
+    if (m.optional_) {
+      source << "c." << m.name_ << "_valid_, ";
+    }
+    source << "\"" << m.name_ << "\");\n";
+    if (auto const range = get_range_args(root, m.schema_); range.has_value()) {
+      source << "    ";
+      if (m.optional_) {
+        source << "if (c." << m.name_ << "_valid_.back()) ";
+      }
+      source << "openapi::check_range" << *range << "(c." << m.name_
+             << "_.back(), \"" << m.name_ << "\");\n";
+    }
+  }
+  source << "  }\n"
+         << "  return c;\n"
+         << "}\n\n";
+
+  // COLUMNS -> JSON
+  header << "  friend void tag_invoke(boost::json::value_from_tag, "
+            "boost::json::value&, "
+         << cols << " const&);\n\n";
+  source << "void tag_invoke(boost::json::value_from_tag, boost::json::value& "
+            "jv, "
+         << cols << " const& c) {\n"
+         << "  auto& arr = jv.emplace_array();\n"
+         << "  arr.reserve(c.size());\n"
+         << "  for (auto i = std::size_t{0U}; i != c.size(); ++i) {\n"
+         << "    auto& o = arr.emplace_back(boost::json::object{arr.storage()})"
+            ".as_object();\n";
+  for (auto const& m : members) {
+    source << "    openapi::write_column(o, c." << m.name_ << "_, ";
+    if (m.optional_) {
+      source << "c." << m.name_ << "_valid_, ";
+    }
+    source << "i, \"" << m.name_ << "\");\n";
+  }
+  source << "  }\n"
+         << "}\n\n";
+
+  for (auto const& m : members) {
+    header << "  std::vector<" << get_type(root, m.name_, m.schema_) << "> "
+           << m.name_ << "_;\n";
+    if (m.optional_) {
+      header << "  std::vector<bool> " << m.name_ << "_valid_;\n";
+    }
+  }
+  header << "};\n\n";
+}
+
+std::optional<std::string> struct_ref(YAML::Node const& root,
+                                      YAML::Node const& schema) {
+  auto const items = schema["items"];
+  auto const s = items.IsDefined() ? items : schema;
+  auto const ref = s["$ref"];
+  if (!ref.IsDefined() || !resolve_object(root, s)["properties"].IsDefined()) {
+    return std::nullopt;
+  }
+  return std::string{ref_name(ref)};
+}
+
+void gen_fields(std::string_view name,
+                YAML::Node const& root,
+                std::vector<member> const& members,
+                std::ostream& header,
+                std::ostream& source) {
+  auto const fields = std::string{name} + "Fields";
+
+  header << "struct " << fields << " {\n"
+         << "  static " << fields << " all();\n"
+         << "  void add(std::string_view path);\n"
+         << "  bool operator==(" << fields << " const&) const = default;\n\n";
+  if (!members.empty()) {
+    header << "  openapi::presence<" << members.size() << "> selected_{};\n";
+  }
+  for (auto const& m : members) {
+    if (auto const ref = struct_ref(root, m.schema_); ref.has_value()) {
+      header << "  openapi::nested_fields<" << *ref << "Fields> " << m.name_
+             << "_{};\n";
+    }
+  }
+  header << "};\n\n";
+
+  header << "void parse(std::string_view, " << fields << "&);\n";
+  header << "void write_projected(boost::json::value&, " << name
+         << " const&, " << fields << " const&);\n\n";
+
+  // ALL
+  source << fields << " " << fields << "::all() {\n"
+         << "  auto f = " << fields << "{};\n";
+  for (auto const [i, m] : utl::enumerate(members)) {
+    source << "  f.selected_.set(" << i << "U);\n";
+  }
+  source << "  return f;\n"
+         << "}\n\n";
+
+  // ADD PATH
+  source << "void " << fields << "::add(std::string_view path) {\n"
+         << "  auto const dot = path.find('.');\n"
+         << "  auto const head = path.substr(0U, dot);\n"
+         << "  auto const tail = dot == std::string_view::npos\n"
+         << "                        ? std::string_view{}\n"
+         << "                        : path.substr(dot + 1U);\n"
+         << "  switch (cista::hash(head)) {\n";
+  for (auto const [i, m] : utl::enumerate(members)) {
+    source << "    case cista::hash(\"" << m.name_ << "\"):\n";
+    if (struct_ref(root, m.schema_).has_value()) {
+      source << "      " << m.name_ << "_.add(tail, selected_.test(" << i
+             << "U));\n";
+    } else {
+      source << "      utl::verify(tail.empty(), \"field {} has no members\", "
+                "head);\n";
+    }
+    source << "      selected_.set(" << i << "U);\n"
+           << "      return;\n";
+  }
+  source << "  }\n"
+         << "  throw utl::fail(\"" << name << ": unknown field {}\", head);\n"
+         << "}\n\n";
+
+  // PARSE
+  source << "void parse(std::string_view s, " << fields << "& f) {\n"
+         << "  f = " << fields << "{};\n"
+         << "  utl::for_each_token(s, ',', [&](auto&& token) {\n"
+         << "    if (!token.view().empty()) {\n"
+         << "      f.add(token.view());\n"
+         << "    }\n"
+         << "  });\n"
+         << "}\n\n";
+
+  // PROJECTED TYPE -> JSON
+  source << "void write_projected(boost::json::value& jv, " << name
+         << " const& v, " << fields << " const& f) {\n"
+         << "  auto& o = jv.emplace_object();\n";
+  for (auto const [i, m] : utl::enumerate(members)) {
+    auto const presence =
+        m.bit_.has_value() ? fmt::format("v.present_, {}U, ", *m.bit_)
+                           : std::string{};
+    auto const write_member = fmt::format(
+        "openapi::write_member(o, v.{}_, {}\"{}\"{});\n", m.name_, presence,
+        m.name_, codec_arg(root, m.schema_));
+    source << "  if (f.selected_.test(" << i << "U)) {\n";
+    if (struct_ref(root, m.schema_).has_value()) {
+      source << "    if (f." << m.name_ << "_.all()) {\n"
+             << "      " << write_member << "    } else {\n"
+             << "      openapi::write_projected_member(o, v." << m.name_
+             << "_, *f." << m.name_ << "_, " << presence << "\"" << m.name_
+             << "\");\n"
+             << "    }\n";
+    } else {
+      source << "    " << write_member;
+    }
+    source << "  }\n";
+  }
+  source << "}\n\n";
+}
+
+void gen_lazy(std::string_view name,
+              YAML::Node const& root,
+              std::vector<member> const& members,
+              std::ostream& header,
+              std::ostream& source) {
+  auto const lazy = std::string{name} + "Lazy";
+
+  header << "// Keeps the raw JSON of a " << name
+         << " and decodes members on first access.\n"
+         << "// Not thread-safe: accessors fill a mutable cache.\n"
+         << "struct " << lazy << " {\n"
+         << "  explicit " << lazy << "(std::string);\n\n";
+  for (auto const& m : members) {
+    header << "  " << get_type(root, m.name_, m.schema_, m.required_)
+           << " const& " << m.name_ << "() const;\n";
+  }
+  header << "\n  " << name << " get() const;\n\n"
+         << "  std::string raw_;\n"
+         << "  std::array<openapi::lazy_span, " << members.size()
+         << "U> spans_{};\n"
+         << "  mutable openapi::presence<" << members.size()
+         << "> decoded_{};\n";
+  for (auto const& m : members) {
+    header << "  mutable " << get_type(root, m.name_, m.schema_, m.required_)
+           << " " << m.name_ << "_{};\n";
+  }
+  header << "};\n\n";
+
+  source << lazy << "::" << lazy << "(std::string json)\n"
+         << "    : raw_{std::move(json)} {\n"
+         << "  openapi::for_each_member(\n"
+         << "      raw_, [&](std::string_view key, std::string_view value) {\n"
+         << "        auto const span = openapi::lazy_span::of(raw_, value);\n"
+         << "        switch (cista::hash(key)) {\n";
+  for (auto const [i, m] : utl::enumerate(members)) {
+    source << "          case cista::hash(\"" << m.name_ << "\"): spans_[" << i
+           << "U] = span; break;\n";
+  }
+  source << "          default: break;\n"
+         << "        }\n"
+         << "      });\n"
+         << "}\n\n";
+
+  for (auto const [i, m] : utl::enumerate(members)) {
+    auto const range = get_range_args(root, m.schema_);
+    auto const check =
+        range.has_value()
+            ? fmt::format("    openapi::check_range{}({}_, \"{}\");\n",
+                          *range, m.name_, m.name_)
+            : std::string{};
+    source << fmt::format(R"({0} const& {1}::{2}() const {{
+  if (!decoded_.test({3}U)) {{
+    openapi::decode_lazy(raw_, spans_[{3}U], {2}_, "{2}"{4});
+{5}    decoded_.set({3}U);
+  }}
+  return {2}_;
+}}
+
+)",
+                          get_type(root, m.name_, m.schema_, m.required_),
+                          lazy, m.name_, i, codec_arg(root, m.schema_), check);
+  }
+
+  source << name << " " << lazy << "::get() const {\n"
+         << "  auto v = " << name << "{};\n";
+  for (auto const& m : members) {
+    if (m.bit_.has_value()) {
+      source << "  if (auto const& x = " << m.name_
+             << "(); x.has_value()) {\n"
+             << "    v.set_" << m.name_ << "(*x);\n"
+             << "  }\n";
+    } else {
+      source << "  v." << m.name_ << "_ = " << m.name_ << "();\n";
+    }
+  }
+  source << "  return v;\n"
+         << "}\n\n";
+}
+
+// Slicing conversion of a flattened allOf struct to one of its bases.
+void gen_slicing(std::string_view name,
+                 std::string_view base,
+                 YAML::Node const& root,
+                 std::vector<member> const& members,
+                 std::ostream& header,
+                 std::ostream& source) {
+  auto const base_members =
+      get_members(resolve_object(root, root["components"]["schemas"][base]));
+
+  header << "  operator " << base << "() const;\n";
+  source << name << "::operator " << base << "() const {\n"
+         << "  auto x = " << base << "{};\n";
+  for (auto const& b : base_members) {
+    auto const it = std::ranges::find(members, b.name_, &member::name_);
+    utl::verify(it != end(members), "{}: missing base member {}", name,
+                b.name_);
+    auto const& m = *it;
+    auto const type = get_type(root, m.name_, m.schema_);
+    auto const base_type = get_type(root, b.name_, b.schema_);
+    utl::verify(type == base_type,
+                "{}: member {} redeclared as {}, base {} declares {}", name,
+                m.name_, type, base, base_type);
+
+    auto const set_bit = b.bit_.has_value()
+                             ? fmt::format("x.present_.set({}U);", *b.bit_)
+                             : std::string{};
+    if (m.bit_.has_value()) {
+      source << "  if (present_.test(" << *m.bit_ << "U)) {\n"
+             << "    x." << m.name_ << "_ = " << m.name_ << "_;\n";
+    } else if (m.optional_ && (b.bit_.has_value() || !b.optional_)) {
+      source << "  if (" << m.name_ << "_.has_value()) {\n"
+             << "    x." << m.name_ << "_ = *" << m.name_ << "_;\n";
+    } else {
+      source << "  x." << m.name_ << "_ = " << m.name_ << "_;"
+             << (set_bit.empty() ? "" : "\n  ") << set_bit << "\n";
+      continue;
+    }
+    if (!set_bit.empty()) {
+      source << "    " << set_bit << "\n";
+    }
+    source << "  }\n";
+  }
+  source << "  return x;\n"
+         << "}\n\n";
+}
+
+// oneOf / anyOf of $refs with a discriminator: a std::variant whose decoder
+// looks up the discriminator property and converts straight to the mapped
+// alternative. Alternatives that don't declare the property get it added on
+// encoding.
+void gen_variant(std::string_view name,
+                 YAML::Node const& root,
+                 YAML::Node const& schema,
+                 std::ostream& header,
+                 std::ostream& source) {
+  auto const alternatives =
+      schema["oneOf"].IsDefined() ? schema["oneOf"] : schema["anyOf"];
+  auto const discriminator = schema["discriminator"];
+  utl::verify(discriminator.IsDefined(),
+              "{}: oneOf/anyOf requires a discriminator", name);
+  auto const prop = discriminator["propertyName"].as<std::string>();
+
+  auto types = std::vector<std::string>{};
+  auto declares_prop = std::vector<bool>{};
+  for (auto const& alt : alternatives) {
+    utl::verify(alt["$ref"].IsDefined(), "{}: alternatives must be $refs",
+                name);
+    auto const type = std::string{ref_name(alt["$ref"])};
+    utl::verify(std::ranges::find(types, type) == end(types),
+                "{}: duplicate alternative {}", name, type);
+    types.push_back(type);
+    declares_prop.push_back(
+        resolve_object(root, alt)["properties"][prop].IsDefined());
+  }
+
+  auto tags = std::vector<std::pair<std::string, std::size_t>>{};
+  auto const add_tag = [&](std::string tag, std::string_view type) {
+    auto const it = std::ranges::find(types, type);
+    utl::verify(it != end(types), "{}: {} is not an alternative", name, type);
+    tags.emplace_back(std::move(tag), static_cast<std::size_t>(
+                                          std::distance(begin(types), it)));
+  };
+  for (auto const& m : discriminator["mapping"]) {
+    auto const target = m.second.as<std::string_view>();
+    add_tag(m.first.as<std::string>(),
+            target.starts_with("#/") ? ref_name(m.second) : target);
+  }
+  for (auto const& type : types) {
+    if (std::ranges::none_of(tags, [&](auto const& t) {
+          return types[t.second] == type;
+        })) {
+      add_tag(type, type);
+    }
+  }
+
+  // Tag written on encoding for alternatives without the property. It must
+  // be unique: with several tags the decoded one could not be written back.
+  auto added_tags = std::vector<std::string>(types.size());
+  for (auto i = std::size_t{0U}; i != types.size(); ++i) {
+    if (!declares_prop[i]) {
+      utl::verify(std::ranges::count(tags, i, [](auto const& t) {
+                    return t.second;
+                  }) == 1,
+                  "{}: {} is mapped by several {} values but does not "
+                  "declare {}",
+                  name, types[i], prop, prop);
+      added_tags[i] =
+          std::ranges::find(tags, i, [](auto const& t) { return t.second; })
+              ->first;
+    }
+  }
+  auto const has_added_tags =
+      std::ranges::any_of(added_tags, [](auto const& t) { return !t.empty(); });
+
+  auto variant = std::string{"std::variant<"};
+  for (auto const [i, type] : utl::enumerate(types)) {
+    variant += (i == 0U ? "" : ", ") + type;
+  }
+  variant += '>';
+
+  header << "struct " << name << " : " << variant << " {\n"
+         << "  using " << variant << "::variant;\n\n"
+         << "  friend std::ostream& operator<<(std::ostream&, " << name
+         << " const&);\n"
+         << "  friend " << name << " tag_invoke(boost::json::value_to_tag<"
+         << name << ">, boost::json::value const&);\n"
+         << "  friend void tag_invoke(boost::json::value_from_tag, "
+            "boost::json::value&, "
+         << name << " const&);\n"
+         << "};\n\n"
+         << "std::size_t serialized_size(" << name << " const&);\n\n";
+
+  source << "std::ostream& operator<<(std::ostream& out, " << name
+         << " const& x) {\n"
+         << "  return out << "
+            "boost::json::serialize(boost::json::value_from(x));\n"
+         << "}\n\n";
+
+  // JSON -> TYPE
+  source << name << " tag_invoke(boost::json::value_to_tag<" << name
+         << ">, boost::json::value const& jv) {\n"
+         << "  auto const& o = jv.as_object();\n"
+         << "  auto const it = o.find(\"" << prop << "\");\n"
+         << "  utl::verify(it != o.end() && it->value().is_string(),\n"
+         << "              \"" << name << ": missing discriminator " << prop
+         << "\");\n"
+         << "  auto const tag = std::string_view{it->value().get_string()};\n"
+         << "  switch (cista::hash(tag)) {\n";
+  for (auto const& [tag, i] : tags) {
+    source << "    case cista::hash(\"" << tag << "\"):\n"
+           << "      if (tag == \"" << tag << "\") {\n"
+           << "        return " << name << "{boost::json::value_to<" << types[i]
+           << ">(jv)};\n"
+           << "      }\n"
+           << "      break;\n";
+  }
+  source << "    default: break;\n"
+         << "  }\n"
+         << "  throw utl::fail(\"" << name << ": unknown " << prop
+         << " {}\", tag);\n"
+         << "}\n\n";
+
+  auto const gen_added_tags = [&]() {
+    source << "  static constexpr auto const kAddedTags = "
+              "std::array<std::string_view, "
+           << types.size() << "U>{";
+    for (auto const [i, tag] : utl::enumerate(added_tags)) {
+      source << (i == 0U ? "" : ", ") << '"' << tag << '"';
+    }
+    source << "};\n";
+  };
+
+  // TYPE -> JSON
+  source << "void tag_invoke(boost::json::value_from_tag, "
+            "boost::json::value& jv, "
+         << name << " const& v) {\n"
+         << "  std::visit([&](auto const& x) { boost::json::value_from(x, jv); "
+            "}, v);\n";
+  if (has_added_tags) {
+    gen_added_tags();
+    source << "  if (auto const tag = kAddedTags[v.index()]; !tag.empty()) {\n"
+           << "    jv.as_object().emplace(\"" << prop << "\", tag);\n"
+           << "  }\n";
+  }
+  source << "}\n\n";
+
+  // SERIALIZED SIZE
+  source << "std::size_t serialized_size(" << name << " const& v) {\n"
+         << "  auto const n = std::visit(\n"
+            "      [](auto const& x) { return serialized_size(x); }, v);\n";
+  if (has_added_tags) {
+    gen_added_tags();
+    source << "  auto const tag = kAddedTags[v.index()];\n"
+           << "  return tag.empty() ? n\n"
+           << "                     : n + (n == 2U ? 0U : 1U) + "
+           << prop.size() + 5U << "U + tag.size();\n";
+  } else {
+    source << "  return n;\n";
+  }
+  source << "}\n\n";
+}
+
+void gen_type(std::string_view name,
+              YAML::Node const& root,
+              YAML::Node const& schema,
+              std::ostream& header,
+              std::ostream& source,
+              std::vector<std::string_view> const& bases = {}) {
+  if (schema["$ref"].IsDefined()) {
+    return;
+  }
+
+  if (schema["x-cpp-type"].IsDefined()) {
+    header << "using " << name << " = " << get_type(root, name, schema)
+           << ";\n\n";
+    return;
+  }
+
+  if (schema["allOf"].IsDefined()) {
+    auto refs = std::vector<std::string_view>{};
+    for (auto const& part : schema["allOf"]) {
+      if (part["$ref"].IsDefined() &&
+          resolve_object(root, part)["properties"].IsDefined()) {
+        refs.push_back(ref_name(part["$ref"]));
+      }
+    }
+    gen_type(name, root, flatten_all_of(root, schema), header, source, refs);
+    return;
+  }
+
+  if (schema["oneOf"].IsDefined() || schema["anyOf"].IsDefined()) {
+    gen_variant(name, root, schema, header, source);
+    return;
+  }
+
+  auto const type = to_type(schema);
+
   if (gen_enum(name, schema, header, source)) {
     return;
   }
@@ -417,14 +1627,35 @@ void gen_type(std::string_view name,
     auto const& items = schema["items"];
     if (items.IsDefined()) {
       gen_enum(prop_name, items, header, source);
+    } else if (is_flat_map(prop_schema)) {
+      gen_enum(prop_name, prop_schema["additionalProperties"], header, source);
     } else {
       gen_enum(prop_name, prop_schema, header, source);
     }
   }
 
+  if (type == type::kObject && is_flat_map(schema) &&
+      !schema["properties"].IsDefined()) {
+    gen_enum(name, schema["additionalProperties"], header, source);
+    header << "using " << name << " = " << get_type(root, name, schema)
+           << ";\n\n";
+    return;
+  }
+
   switch (type) {
-    case type::kObject:
+    case type::kObject: {
+      auto const members = get_members(schema);
+      auto const n_bits = count_bits(members);
+
+      auto const lazy = has_extension(schema, "x-lazy");
+      if (lazy) {
+        header << "struct " << name << "Lazy;\n\n";
+      }
+
       header << "struct " << name << " {\n";
+      if (lazy) {
+        header << "  using lazy_t = " << name << "Lazy;\n";
+      }
 
       header << fmt::format(R"(
   auto operator<=>({} const&) const;
@@ -468,11 +1699,16 @@ bool {}::operator>=({} const&) const = default;
                 "boost::json::value const& jv) {\n"
                 "    auto v = "
              << name << "{};\n";
-      for (auto const& p : schema["properties"]) {
-        auto const member_name = p.first.as<std::string_view>();
-        source << "    openapi::extract_member(jv.as_object(), v."
-               << member_name << "_, \"" << member_name << "\");\n";
+      for (auto const& m : members) {
+        source << "    openapi::extract_member(jv.as_object(), v." << m.name_
+               << "_, ";
+        if (m.bit_.has_value()) {
+          source << "v.present_, " << *m.bit_ << "U, ";
+        }
+        source << "\"" << m.name_ << "\"" << codec_arg(root, m.schema_)
+               << ");\n";
       }
+      gen_range_checks(root, members, "v", "    ", source);
       source << "    return v;\n"
                 "  }\n\n";
 
@@ -480,29 +1716,124 @@ bool {}::operator>=({} const&) const = default;
       header << "  friend void tag_invoke(boost::json::value_from_tag, "
                 "boost::json::value& "
                 "jv, "
-             << name << " const& v);\n\n";
+             << name << " const& v);\n";
 
       source << "void tag_invoke(boost::json::value_from_tag, "
                 "boost::json::value& "
                 "jv, "
              << name
              << " const& v) {\n"
-                "    auto& o = (jv = boost::json::object{}).as_object();\n";
-      for (auto const& p : schema["properties"]) {
-        auto const member_name = p.first.as<std::string_view>();
-        source << "    openapi::write_member(o, v." << member_name << "_, \""
-               << member_name << "\");\n";
+                "    auto& o = jv.emplace_object();\n";
+      for (auto const& m : members) {
+        source << "    openapi::write_member(o, v." << m.name_ << "_, ";
+        if (m.bit_.has_value()) {
+          source << "v.present_, " << *m.bit_ << "U, ";
+        }
+        source << "\"" << m.name_ << "\"" << codec_arg(root, m.schema_)
+               << ");\n";
       }
       source << "  }\n\n";
 
-      for (auto const& p : schema["properties"]) {
-        auto const member_name = p.first.as<std::string_view>();
-        auto const required =
-            is_in_required_list(member_name) || is_required(p.second);
-        gen_member(root, member_name, required, p.second, header);
+      gen_accessors(root, members, header);
+      header << "\n";
+
+      for (auto const& base : bases) {
+        gen_slicing(name, base, root, members, header, source);
+      }
+      if (!bases.empty()) {
+        header << "\n";
+      }
+
+      for (auto const& m : members) {
+        gen_member(root, m.name_, m.required_ || m.bit_.has_value(), m.schema_,
+                   header);
+      }
+      if (n_bits != 0U) {
+        header << "  openapi::presence<" << n_bits << "> present_{};\n";
       }
       header << "};\n\n";
+
+      // SERIALIZED SIZE
+      header << "std::size_t serialized_size(" << name << " const&);\n";
+      source << "std::size_t serialized_size(" << name << " const& v) {\n"
+             << "  auto n = std::size_t{0U};\n"
+             << "  auto n_members = std::size_t{0U};\n";
+      for (auto const& m : members) {
+        source << "  n += openapi::member_size(v." << m.name_ << "_, ";
+        if (m.bit_.has_value()) {
+          source << "v.present_, " << *m.bit_ << "U, ";
+        }
+        source << m.name_.size() + 3U << "U, n_members"
+               << codec_arg(root, m.schema_) << ");\n";
+      }
+      source << "  return openapi::object_size(n, n_members);\n"
+             << "}\n\n";
+
+      // MERGE PATCH
+      header << "void diff(" << name << " const&, " << name
+             << " const&, boost::json::object&);\n";
+      source << "void diff(" << name << " const& a, " << name
+             << " const& b, boost::json::object& patch) {\n";
+      for (auto const& m : members) {
+        source << "  openapi::diff_member(patch, a." << m.name_ << "_, ";
+        if (m.bit_.has_value()) {
+          source << "a.present_, b." << m.name_ << "_, b.present_, " << *m.bit_
+                 << "U, ";
+        } else {
+          source << "b." << m.name_ << "_, ";
+        }
+        source << "\"" << m.name_ << "\"" << codec_arg(root, m.schema_)
+               << ");\n";
+      }
+      source << "}\n\n";
+
+      // Patches a copy, so the target is unchanged if the patch is rejected.
+      header << "void apply_patch(" << name
+             << "&, boost::json::value const&);\n\n";
+      source << "void apply_patch(" << name
+             << "& target, boost::json::value const& patch) {\n"
+             << "  if (!patch.is_object()) {\n"
+             << "    target = boost::json::value_to<" << name << ">(patch);\n"
+             << "    return;\n"
+             << "  }\n"
+             << "  auto x = target;\n"
+             << "  auto const& o = patch.as_object();\n";
+      for (auto const& m : members) {
+        source << "  openapi::patch_member(o, x." << m.name_ << "_, ";
+        if (m.bit_.has_value()) {
+          source << "x.present_, " << *m.bit_ << "U, ";
+        }
+        source << "\"" << m.name_ << "\"" << codec_arg(root, m.schema_)
+               << ");\n";
+      }
+      gen_range_checks(root, members, "x", "  ", source);
+      source << "  target = std::move(x);\n"
+             << "}\n\n";
+
+      // FIELD PROJECTION
+      gen_fields(name, root, members, header, source);
+
+      // STREAMING
+      header << "void write_element(openapi::chunk_sink&, " << name
+             << " const&);\n\n";
+      source << "void write_element(openapi::chunk_sink& out, " << name
+             << " const& x) {\n"
+             << "  auto buf = std::array<unsigned char, 4096U>{};\n"
+             << "  auto mr = boost::json::monotonic_resource{buf.data(), "
+                "buf.size()};\n"
+             << "  out.write(boost::json::value_from(x, "
+                "boost::json::storage_ptr{&mr}));\n"
+             << "}\n\n";
+
+      if (has_extension(schema, "x-columns")) {
+        gen_columns(name, root, members, header, source);
+      }
+
+      if (lazy) {
+        gen_lazy(name, root, members, header, source);
+      }
       break;
+    }
 
     case type::kArray:
       gen_enum(std::string{name}, schema["items"], header, source);
@@ -515,12 +1846,240 @@ bool {}::operator>=({} const&) const = default;
   }
 }
 
+void gen_stream(std::string_view name,
+                YAML::Node const& root,
+                YAML::Node const& schema,
+                std::ostream& header) {
+  auto const items = schema["items"];
+  if (schema["$ref"].IsDefined() || !items.IsDefined() ||
+      !items["$ref"].IsDefined() ||
+      !resolve_object(root, items)["properties"].IsDefined()) {
+    return;
+  }
+
+  header << "template <std::ranges::input_range R>\n"
+         << "void stream_" << name
+         << "(R&& items, openapi::chunk_sink& out) {\n"
+         << "  openapi::stream_array(std::forward<R>(items), out);\n"
+         << "}\n\n";
+}
+
+// Request and response schemas that reference a component become aliases.
+void gen_operation_type(std::string_view name,
+                        YAML::Node const& root,
+                        YAML::Node const& schema,
+                        std::ostream& header,
+                        std::ostream& source) {
+  if (schema["$ref"].IsDefined()) {
+    header << "using " << name << " = " << get_type(root, name, schema, true)
+           << ";\n\n";
+  } else {
+    gen_type(name, root, schema, header, source);
+  }
+}
+
+std::string_view to_method_enum(std::string_view const method) {
+  switch (cista::hash(method)) {
+    case cista::hash("get"): return "kGet";
+    case cista::hash("put"): return "kPut";
+    case cista::hash("post"): return "kPost";
+    case cista::hash("delete"): return "kDelete";
+    case cista::hash("options"): return "kOptions";
+    case cista::hash("head"): return "kHead";
+    case cista::hash("patch"): return "kPatch";
+    case cista::hash("trace"): return "kTrace";
+  }
+  throw utl::fail("unsupported HTTP method {}", method);
+}
+
+void gen_path(std::string_view op,
+              YAML::Node const& n,
+              std::vector<std::string_view> const& path_params,
+              std::ostream& header) {
+  for (auto const& p : n["parameters"]) {
+    if (is_path_param(p)) {
+      auto const name = p["name"].as<std::string_view>();
+      utl::verify(std::ranges::find(path_params, name) != end(path_params),
+                  "{}: path parameter {} not in path", op, name);
+    }
+  }
+
+  header << "struct " << op << "_path {\n";
+  for (auto const& name : path_params) {
+    header << "  std::string_view " << name << "_;\n";
+  }
+  header << "};\n\n";
+}
+
+// Path template segment trie: one match function per node. Literal segments
+// are selected by a switch on the segment hash and take precedence over a
+// path parameter at the same position. Path parameters never match empty
+// segments.
+struct route_node {
+  std::map<std::string_view, std::unique_ptr<route_node>> literals_;
+  std::unique_ptr<route_node> param_;
+  std::map<std::string_view, std::string> methods_;
+};
+
+void add_route(route_node& root,
+               std::string_view path,
+               std::string_view method,
+               std::string op) {
+  auto node = &root;
+  auto seg = std::string_view{};
+  while (next_segment(path, seg)) {
+    auto& next =
+        path_param_name(seg).has_value() ? node->param_ : node->literals_[seg];
+    if (next == nullptr) {
+      next = std::make_unique<route_node>();
+    }
+    node = next.get();
+  }
+  auto const [_, inserted] =
+      node->methods_.emplace(to_method_enum(method), std::move(op));
+  utl::verify(inserted, "ambiguous route {} {}", method, path);
+}
+
+unsigned gen_route_node(route_node const& n,
+                        unsigned const n_params,
+                        unsigned& next_id,
+                        std::ostream& source) {
+  auto literals = std::vector<std::pair<std::string_view, unsigned>>{};
+  for (auto const& [seg, child] : n.literals_) {
+    literals.emplace_back(seg,
+                          gen_route_node(*child, n_params, next_id, source));
+  }
+  auto param = std::optional<unsigned>{};
+  if (n.param_ != nullptr) {
+    param = gen_route_node(*n.param_, n_params + 1U, next_id, source);
+  }
+
+  auto const id = next_id++;
+  source << "bool match_route_" << id
+         << "(openapi::http_method const method,\n"
+            "                   std::string_view path,\n"
+            "                   route_match& m) {\n"
+            "  auto segment = std::string_view{};\n"
+            "  if (!openapi::next_segment(path, segment)) {\n";
+  if (n.methods_.empty()) {
+    source << "    return false;\n";
+  } else {
+    source << "    switch (method) {\n";
+    for (auto const& [method, op] : n.methods_) {
+      source << "      case openapi::http_method::" << method << ":\n"
+             << "        m.status_ = openapi::route_status::kFound;\n"
+             << "        m.op_ = operation_id::" << op << ";\n"
+             << "        return true;\n";
+    }
+    source << "      default:\n"
+              "        m.status_ = openapi::route_status::kMethodNotAllowed;\n"
+              "        return false;\n"
+              "    }\n";
+  }
+  source << "  }\n";
+
+  if (!literals.empty()) {
+    source << "  switch (cista::hash(segment)) {\n";
+    for (auto const& [seg, child] : literals) {
+      source << "    case cista::hash(\"" << seg << "\"):\n"
+             << "      if (segment == \"" << seg << "\" && match_route_"
+             << child << "(method, path, m)) {\n"
+             << "        return true;\n"
+             << "      }\n"
+             << "      break;\n";
+    }
+    source << "    default: break;\n"
+              "  }\n";
+  }
+
+  if (param.has_value()) {
+    source << "  m.path_params_[" << n_params << "U] = segment;\n"
+           << "  return !segment.empty() && match_route_" << *param
+           << "(method, path, m);\n";
+  } else {
+    source << "  return false;\n";
+  }
+  source << "}\n\n";
+
+  return id;
+}
+
+struct route {
+  std::string op_;
+  std::vector<std::string_view> path_params_;
+};
+
+void gen_router(route_node const& trie,
+                std::vector<route> const& routes,
+                std::ostream& header,
+                std::ostream& source) {
+  auto max_params = std::size_t{0U};
+  header << "enum class operation_id : std::uint16_t {";
+  auto ind = indent{1};
+  for (auto const& r : routes) {
+    ind(header);
+    header << r.op_;
+    max_params = std::max(max_params, r.path_params_.size());
+  }
+  header << "\n};\n\n";
+
+  header << "struct route_match {\n"
+            "  openapi::route_status status_{"
+            "openapi::route_status::kNotFound};\n"
+            "  operation_id op_{};\n"
+            "  std::array<std::string_view, "
+         << max_params
+         << "U> path_params_{};\n"
+            "};\n\n";
+
+  header << R"(// Matches a percent-encoded path (without query) against the
+// paths of the spec. Path parameters are returned as views into the path.
+route_match match_route(openapi::http_method, std::string_view path);
+
+// Calls handler with the <operation>_path of the matched operation (or the
+// route_status if there is none) followed by args.
+template <typename Handler, typename... Args>
+std::invoke_result_t<Handler&, openapi::route_status, Args&&...> dispatch(
+    route_match const& m, Handler&& handler, Args&&... args) {
+  if (m.status_ != openapi::route_status::kFound) {
+    return handler(m.status_, std::forward<Args>(args)...);
+  }
+  switch (m.op_) {
+)";
+  for (auto const& r : routes) {
+    header << "    case operation_id::" << r.op_ << ":\n"
+           << "      return handler(" << r.op_ << "_path{";
+    for (auto const [i, _] : utl::enumerate(r.path_params_)) {
+      header << (i == 0U ? "" : ", ") << "m.path_params_[" << i << "U]";
+    }
+    header << "}, std::forward<Args>(args)...);\n";
+  }
+  header << "  }\n"
+            "  std::unreachable();\n"
+            "}\n\n";
+
+  auto next_id = 0U;
+  source << "namespace {\n\n";
+  auto const root_id = gen_route_node(trie, 0U, next_id, source);
+  source << "}  // namespace\n\n";
+  source << "route_match match_route(openapi::http_method const method,\n"
+            "                        std::string_view const path) {\n"
+            "  auto m = route_match{};\n"
+            "  if (path.starts_with('/')) {\n"
+            "    match_route_"
+         << root_id
+         << "(method, path, m);\n"
+            "  }\n"
+            "  return m;\n"
+            "}\n\n";
+}
+
 void write_types(YAML::Node const& root,
                  std::string_view path_to_header,
                  std::ostream& header,
                  std::ostream& source,
                  std::optional<std::string_view> ns) {
-  write_prelude(path_to_header, header, source, ns);
+  write_prelude(path_to_header, get_includes(root), header, source, ns);
 
   auto const components = root["components"];
   if (components.IsDefined()) {
@@ -529,19 +2088,88 @@ void write_types(YAML::Node const& root,
     }
   }
 
+  auto operations = std::vector<std::string>{};
+  auto routes = std::vector<route>{};
+  auto trie = route_node{};
   for (auto const& path : root["paths"]) {
+    auto const path_template = path.first.as<std::string_view>();
+    auto const path_params = get_path_params(path_template);
     for (auto const& method : path.second) {
-      write_params(root, method.second, header, source);
+      auto const op = method.second["operationId"].as<std::string>();
+      operations.push_back(op);
+      routes.push_back({op, path_params});
+      add_route(trie, path_template, method.first.as<std::string_view>(), op);
+
+      header << "extern openapi::operation_metrics " << op << "_metrics;\n\n";
+      source << "openapi::operation_metrics " << op << "_metrics{\"" << op
+             << "\"};\n\n";
+
+      gen_path(op, method.second, path_params, header);
+      write_params(root, path_template, method.second, header, source);
+
+      if (auto const body = method.second["requestBody"]; body.IsDefined()) {
+        auto const name = op + "_request";
+        gen_operation_type(name, root,
+                           body["content"]["application/json"]["schema"],
+                           header, source);
+        header << name << " decode_" << name << "(std::string_view);\n\n";
+        source << fmt::format(R"({0} decode_{0}(std::string_view body) try {{
+  auto const timer = openapi::scoped_timer{{{1}_metrics.body_decode_ns_,
+                                           "{1}.body_decode"}};
+  {1}_metrics.request_bytes_.record(body.size());
+  return boost::json::value_to<{0}>(boost::json::parse(body));
+}} catch (...) {{
+  {1}_metrics.count_error();
+  throw;
+}}
+
+)",
+                              name, op);
+      }
 
       for (auto const& response : method.second["responses"]) {
-        gen_type(method.second["operationId"].as<std::string>() + "_response",
-                 root, response.second["content"]["application/json"]["schema"],
-                 header, source);
+        auto const name = op + "_response";
+        auto const schema =
+            response.second["content"]["application/json"]["schema"];
+        gen_operation_type(name, root, schema, header, source);
+        gen_stream(name, root, schema, header);
+        header << "using " << name << "_decoder = openapi::stream_decoder<"
+               << name << ">;\n\n";
+
+        header << "std::string encode_" << name << "(" << name
+               << " const&);\n\n";
+        source << fmt::format(R"(std::string encode_{0}({0} const& x) try {{
+  auto const timer = openapi::scoped_timer{{{1}_metrics.response_encode_ns_,
+                                           "{1}.response_encode"}};
+  auto s = openapi::serialize(x);
+  {1}_metrics.response_bytes_.record(s.size());
+  return s;
+}} catch (...) {{
+  {1}_metrics.count_error();
+  throw;
+}}
+
+)",
+                              name, op);
       }
     }
   }
 
+  gen_router(trie, routes, header, source);
+
+  header << "std::span<openapi::operation_metrics* const> all_metrics();\n";
+  source << "std::span<openapi::operation_metrics* const> all_metrics() {\n"
+         << "  static auto const metrics = std::array<"
+            "openapi::operation_metrics*, "
+         << operations.size() << "U>{";
+  for (auto const [i, op] : utl::enumerate(operations)) {
+    source << (i == 0U ? "" : ", ") << '&' << op << "_metrics";
+  }
+  source << "};\n"
+         << "  return metrics;\n"
+         << "}\n";
+
   write_postlude(header, source, ns);
 }
 
-}  // namespace openapi
\ No newline at end of file
+}  // namespace openapi
@@ -1,7 +1,5 @@
 #include "openapi/json.h"
 
-#include "fmt/chrono.h"
-
 namespace openapi {
 
 date_time_t tag_invoke(json::value_to_tag<date_time_t>, json::value const& jv) {
@@ -11,13 +9,59 @@ date_time_t tag_invoke(json::value_to_tag<date_time_t>, json::value const& jv) {
 }
 
 void tag_invoke(json::value_from_tag, json::value& jv, date_time_t const v) {
-  auto const offset_total_minutes = v.offset_.count();
-  auto const offset_hours = offset_total_minutes / 60;
-  auto const offset_minutes = std::abs(offset_total_minutes % 60);
-  jv = v.offset_.count() == 0
-           ? fmt::format("{:%FT%T}Z", v.time_)
-           : fmt::format("{:%FT%T}{:+03d}:{:02d}", v.time_ + v.offset_,
-                         offset_hours, offset_minutes);
+  auto buf = date_time_buf_t{};
+  jv = format(v, buf);
+}
+
+date_t tag_invoke(json::value_to_tag<date_t>, json::value const& jv) {
+  auto d = date_t{};
+  parse(jv.as_string(), d);
+  return d;
+}
+
+void tag_invoke(json::value_from_tag, json::value& jv, date_t const v) {
+  auto buf = date_buf_t{};
+  jv = format(v, buf);
+}
+
+void diff_value(json::object& o,
+                json::value const& a,
+                json::value const& b,
+                json::string_view key) {
+  if (!a.is_object() || !b.is_object()) {
+    if (a != b) {
+      o.emplace(key, b);
+    }
+    return;
+  }
+
+  auto patch = json::object{o.storage()};
+  for (auto const& [k, v] : a.get_object()) {
+    if (!b.get_object().contains(k)) {
+      patch.emplace(k, nullptr);
+    }
+  }
+  for (auto const& [k, v] : b.get_object()) {
+    if (auto const it = a.get_object().find(k); it == a.get_object().end()) {
+      patch.emplace(k, v);
+    } else {
+      diff_value(patch, it->value(), v, k);
+    }
+  }
+  if (!patch.empty()) {
+    o.emplace(key, std::move(patch));
+  }
+}
+
+uuid tag_invoke(json::value_to_tag<uuid>, json::value const& jv) {
+  auto u = uuid{};
+  parse(jv.as_string(), u);
+  return u;
+}
+
+void tag_invoke(json::value_from_tag, json::value& jv, uuid const& u) {
+  auto buf = uuid_buf_t{};
+  jv = format(u, buf);
 }
 
-}  // namespace openapi
\ No newline at end of file
+}  // namespace openapi
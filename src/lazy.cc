@@ -0,0 +1,227 @@
+#include "openapi/lazy.h"
+
+#include <limits>
+#include <string>
+
+#include "boost/json.hpp"
+
+#include "utl/verify.h"
+
+namespace openapi {
+
+namespace json = boost::json;
+
+namespace {
+
+constexpr auto const kMaxDepth = 1024U;
+
+struct scanner {
+  [[noreturn]] void fail(std::string_view what) const {
+    throw utl::fail("invalid json at offset {}: {}", i_, what);
+  }
+
+  void skip_ws() {
+    while (i_ < s_.size() &&
+           (s_[i_] == ' ' || s_[i_] == '\t' || s_[i_] == '\n' ||
+            s_[i_] == '\r')) {
+      ++i_;
+    }
+  }
+
+  char peek() {
+    skip_ws();
+    if (i_ >= s_.size()) {
+      fail("unexpected end");
+    }
+    return s_[i_];
+  }
+
+  void expect(char const c) {
+    if (peek() != c) {
+      fail("unexpected character");
+    }
+    ++i_;
+  }
+
+  bool is_digit() const {
+    return i_ < s_.size() && s_[i_] >= '0' && s_[i_] <= '9';
+  }
+
+  void digits() {
+    if (!is_digit()) {
+      fail("expected digit");
+    }
+    while (is_digit()) {
+      ++i_;
+    }
+  }
+
+  bool is_hex(char const c) const {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
+           (c >= 'A' && c <= 'F');
+  }
+
+  // Returns whether the string contains escape sequences.
+  bool string() {
+    expect('"');
+    auto escaped = false;
+    while (true) {
+      if (i_ >= s_.size()) {
+        fail("unterminated string");
+      }
+      auto const c = s_[i_++];
+      if (c == '"') {
+        return escaped;
+      } else if (c == '\\') {
+        escaped = true;
+        if (i_ >= s_.size()) {
+          fail("unterminated escape");
+        }
+        switch (s_[i_++]) {
+          case '"':
+          case '\\':
+          case '/':
+          case 'b':
+          case 'f':
+          case 'n':
+          case 'r':
+          case 't': break;
+          case 'u':
+            for (auto k = 0U; k != 4U; ++k, ++i_) {
+              if (i_ >= s_.size() || !is_hex(s_[i_])) {
+                fail("invalid unicode escape");
+              }
+            }
+            break;
+          default: fail("invalid escape");
+        }
+      } else if (static_cast<unsigned char>(c) < 0x20U) {
+        fail("control character in string");
+      }
+    }
+  }
+
+  void number() {
+    if (s_[i_] == '-') {
+      ++i_;
+    }
+    if (i_ < s_.size() && s_[i_] == '0') {
+      ++i_;
+    } else {
+      digits();
+    }
+    if (i_ < s_.size() && s_[i_] == '.') {
+      ++i_;
+      digits();
+    }
+    if (i_ < s_.size() && (s_[i_] == 'e' || s_[i_] == 'E')) {
+      ++i_;
+      if (i_ < s_.size() && (s_[i_] == '+' || s_[i_] == '-')) {
+        ++i_;
+      }
+      digits();
+    }
+  }
+
+  void literal(std::string_view const lit) {
+    if (s_.substr(i_, lit.size()) != lit) {
+      fail("invalid literal");
+    }
+    i_ += lit.size();
+  }
+
+  void value(unsigned const depth) {
+    if (depth > kMaxDepth) {
+      fail("nesting too deep");
+    }
+    switch (peek()) {
+      case '{':
+        ++i_;
+        if (peek() == '}') {
+          ++i_;
+          return;
+        }
+        while (true) {
+          string();
+          expect(':');
+          value(depth + 1U);
+          if (peek() == ',') {
+            ++i_;
+            continue;
+          }
+          expect('}');
+          return;
+        }
+      case '[':
+        ++i_;
+        if (peek() == ']') {
+          ++i_;
+          return;
+        }
+        while (true) {
+          value(depth + 1U);
+          if (peek() == ',') {
+            ++i_;
+            continue;
+          }
+          expect(']');
+          return;
+        }
+      case '"': string(); return;
+      case 't': literal("true"); return;
+      case 'f': literal("false"); return;
+      case 'n': literal("null"); return;
+      default: number(); return;
+    }
+  }
+
+  std::string_view s_;
+  std::size_t i_{0U};
+};
+
+}  // namespace
+
+void scan_object(std::string_view json, member_fn_t fn, void* ctx) {
+  utl::verify(json.size() <= std::numeric_limits<std::uint32_t>::max(),
+              "scan_object: input too large");
+
+  auto sc = scanner{.s_ = json};
+  sc.expect('{');
+  if (sc.peek() == '}') {
+    ++sc.i_;
+  } else {
+    while (true) {
+      sc.skip_ws();
+      auto const key_begin = sc.i_;
+      auto const escaped = sc.string();
+      auto key = json.substr(key_begin + 1U, sc.i_ - key_begin - 2U);
+      auto unescaped = std::string{};
+      if (escaped) {
+        [[unlikely]];
+        unescaped = json::value_to<std::string>(
+            json::parse(json.substr(key_begin, sc.i_ - key_begin)));
+        key = unescaped;
+      }
+
+      sc.expect(':');
+      sc.skip_ws();
+      auto const value_begin = sc.i_;
+      sc.value(1U);
+      fn(ctx, key, json.substr(value_begin, sc.i_ - value_begin));
+
+      if (sc.peek() == ',') {
+        ++sc.i_;
+        continue;
+      }
+      sc.expect('}');
+      break;
+    }
+  }
+
+  sc.skip_ws();
+  if (sc.i_ != json.size()) {
+    sc.fail("trailing characters");
+  }
+}
+
+}  // namespace openapi
@@ -0,0 +1,69 @@
+#include "openapi/metrics.h"
+
+#include <ostream>
+
+#include "fmt/ostream.h"
+
+namespace openapi {
+
+namespace {
+
+void write_histogram(std::ostream& out,
+                     std::string_view name,
+                     std::string_view help,
+                     histogram operation_metrics::*member,
+                     std::span<operation_metrics* const> operations) {
+  fmt::print(out, "# HELP openapi_{} {}\n# TYPE openapi_{} histogram\n", name,
+             help, name);
+  for (auto const* op : operations) {
+    auto const& h = op->*member;
+    // Empty buckets are left out: the cumulative counts stay the same.
+    auto cumulative = std::uint64_t{0U};
+    for (auto i = std::size_t{0U}; i != h.buckets_.size(); ++i) {
+      auto const n = h.buckets_[i].load(std::memory_order_relaxed);
+      if (n == 0U) {
+        continue;
+      }
+      cumulative += n;
+      fmt::print(out, "openapi_{}_bucket{{operation=\"{}\",le=\"{}\"}} {}\n",
+                 name, op->operation_id_, histogram::upper_bound(i),
+                 cumulative);
+    }
+    auto const count = h.count_.load(std::memory_order_relaxed);
+    fmt::print(out,
+               "openapi_{0}_bucket{{operation=\"{1}\",le=\"+Inf\"}} {2}\n"
+               "openapi_{0}_sum{{operation=\"{1}\"}} {3}\n"
+               "openapi_{0}_count{{operation=\"{1}\"}} {2}\n",
+               name, op->operation_id_, count,
+               h.sum_.load(std::memory_order_relaxed));
+  }
+}
+
+}  // namespace
+
+void write_prometheus(std::ostream& out,
+                      std::span<operation_metrics* const> operations) {
+  write_histogram(out, "params_parse_nanoseconds",
+                  "Time to parse the query parameters.",
+                  &operation_metrics::params_parse_ns_, operations);
+  write_histogram(out, "body_decode_nanoseconds",
+                  "Time to decode the JSON request body.",
+                  &operation_metrics::body_decode_ns_, operations);
+  write_histogram(out, "response_encode_nanoseconds",
+                  "Time to encode the JSON response.",
+                  &operation_metrics::response_encode_ns_, operations);
+  write_histogram(out, "request_bytes", "Size of the JSON request body.",
+                  &operation_metrics::request_bytes_, operations);
+  write_histogram(out, "response_bytes", "Size of the JSON response.",
+                  &operation_metrics::response_bytes_, operations);
+
+  out << "# HELP openapi_errors_total Failed parses, decodes and encodes.\n"
+      << "# TYPE openapi_errors_total counter\n";
+  for (auto const* op : operations) {
+    fmt::print(out, "openapi_errors_total{{operation=\"{}\"}} {}\n",
+               op->operation_id_,
+               op->errors_.load(std::memory_order_relaxed));
+  }
+}
+
+}  // namespace openapi
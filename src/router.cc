@@ -0,0 +1,37 @@
+#include "openapi/router.h"
+
+#include "cista/hash.h"
+
+#include "utl/verify.h"
+
+namespace openapi {
+
+std::string_view to_str(http_method const m) {
+  switch (m) {
+    case http_method::kGet: return "GET";
+    case http_method::kPut: return "PUT";
+    case http_method::kPost: return "POST";
+    case http_method::kDelete: return "DELETE";
+    case http_method::kOptions: return "OPTIONS";
+    case http_method::kHead: return "HEAD";
+    case http_method::kPatch: return "PATCH";
+    case http_method::kTrace: return "TRACE";
+  }
+  throw utl::fail("invalid http_method value {}", static_cast<int>(m));
+}
+
+void parse(std::string_view const s, http_method& m) {
+  switch (cista::hash(s)) {
+    case cista::hash("GET"): m = http_method::kGet; break;
+    case cista::hash("PUT"): m = http_method::kPut; break;
+    case cista::hash("POST"): m = http_method::kPost; break;
+    case cista::hash("DELETE"): m = http_method::kDelete; break;
+    case cista::hash("OPTIONS"): m = http_method::kOptions; break;
+    case cista::hash("HEAD"): m = http_method::kHead; break;
+    case cista::hash("PATCH"): m = http_method::kPatch; break;
+    case cista::hash("TRACE"): m = http_method::kTrace; break;
+    default: throw utl::fail("http_method: unknown value {}", s);
+  }
+}
+
+}  // namespace openapi
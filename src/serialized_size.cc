@@ -0,0 +1,85 @@
+#include "openapi/serialized_size.h"
+
+#include <algorithm>
+#include <array>
+
+#include "boost/json.hpp"
+
+namespace openapi {
+
+namespace json = boost::json;
+
+std::size_t serialized_size(std::string_view s) {
+  auto n = s.size() + 2U;
+  for (auto const c : s) {
+    switch (c) {
+      case '"':
+      case '\\':
+      case '\b':
+      case '\f':
+      case '\n':
+      case '\r':
+      case '\t': n += 1U; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20U) {
+          n += 5U;
+        }
+    }
+  }
+  return n;
+}
+
+std::size_t serialized_size(double const d) {
+  auto const jv = json::value{d};
+  auto buf = std::array<char, 32U>{};
+  auto sr = json::serializer{};
+  sr.reset(&jv);
+  return sr.read(buf.data(), buf.size()).size();
+}
+
+std::size_t serialized_size(date_time_t const t) {
+  // "YYYY-MM-DDTHH:MM:SS" followed by "Z" or "+HH:MM", plus the quotes.
+  auto const local =
+      std::chrono::floor<std::chrono::days>(t.time_ + t.offset_);
+  auto const year = static_cast<int>(std::chrono::year_month_day{local}.year());
+  // format() pads the year to 4 characters including the sign.
+  auto const year_size = std::max(std::size_t{4U}, serialized_size(year));
+  return 2U + year_size + 15U + (t.offset_.count() == 0 ? 1U : 6U);
+}
+
+std::size_t serialized_size(date_t const d) {
+  auto buf = date_buf_t{};
+  return format(d, buf).size() + 2U;
+}
+
+std::size_t serialized_size(json::value const& jv) {
+  switch (jv.kind()) {
+    case json::kind::null: return 4U;
+    case json::kind::bool_: return serialized_size(jv.get_bool());
+    case json::kind::int64: return serialized_size(jv.get_int64());
+    case json::kind::uint64: return serialized_size(jv.get_uint64());
+    case json::kind::double_: return serialized_size(jv.get_double());
+    case json::kind::string:
+      return serialized_size(std::string_view{jv.get_string()});
+    case json::kind::array: {
+      auto const& arr = jv.get_array();
+      auto n = std::size_t{2U + (arr.empty() ? 0U : arr.size() - 1U)};
+      for (auto const& x : arr) {
+        n += serialized_size(x);
+      }
+      return n;
+    }
+    case json::kind::object: {
+      auto const& o = jv.get_object();
+      auto n = std::size_t{2U + (o.empty() ? 0U : o.size() - 1U)};
+      for (auto const& kv : o) {
+        n += serialized_size(std::string_view{kv.key()}) + 1U +
+             serialized_size(kv.value());
+      }
+      return n;
+    }
+  }
+  std::unreachable();
+}
+
+}  // namespace openapi
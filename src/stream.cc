@@ -0,0 +1,55 @@
+#include "openapi/stream.h"
+
+#include <algorithm>
+
+#include "boost/json.hpp"
+
+#include "utl/verify.h"
+
+namespace openapi {
+
+namespace json = boost::json;
+
+chunk_sink::chunk_sink(std::span<char> buf, flush_fn_t flush)
+    : buf_{buf}, flush_{std::move(flush)} {
+  utl::verify(!buf_.empty(), "chunk_sink: empty buffer");
+}
+
+void chunk_sink::write(char const c) {
+  if (used_ == buf_.size()) {
+    flush();
+  }
+  buf_[used_++] = c;
+}
+
+void chunk_sink::write(std::string_view s) {
+  while (!s.empty()) {
+    if (used_ == buf_.size()) {
+      flush();
+    }
+    auto const n = std::min(s.size(), buf_.size() - used_);
+    std::copy_n(s.data(), n, buf_.data() + used_);
+    used_ += n;
+    s.remove_prefix(n);
+  }
+}
+
+void chunk_sink::write(json::value const& jv) {
+  auto sr = json::serializer{};
+  sr.reset(&jv);
+  while (!sr.done()) {
+    if (used_ == buf_.size()) {
+      flush();
+    }
+    used_ += sr.read(buf_.data() + used_, buf_.size() - used_).size();
+  }
+}
+
+void chunk_sink::flush() {
+  if (used_ != 0U) {
+    flush_(std::string_view{buf_.data(), used_});
+    used_ = 0U;
+  }
+}
+
+}  // namespace openapi
@@ -0,0 +1,112 @@
+#include "openapi/trace.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "fmt/ostream.h"
+
+namespace openapi::trace {
+
+namespace {
+
+struct retired_event {
+  std::uint32_t tid_;
+  event event_;
+};
+
+struct registry {
+  std::mutex mutex_;
+  std::uint32_t next_tid_{1U};
+  std::vector<ring*> rings_;
+  std::deque<retired_event> retired_;
+};
+
+registry& get_registry() {
+  static auto r = registry{};
+  return r;
+}
+
+// Owns the ring of one thread and retires it when the thread exits.
+struct ring_owner {
+  ring_owner() : ring_{std::make_unique<ring>()} {
+    auto& r = get_registry();
+    auto const lock = std::scoped_lock{r.mutex_};
+    ring_->tid_ = r.next_tid_++;
+    r.rings_.push_back(ring_.get());
+  }
+
+  ~ring_owner() {
+    auto& r = get_registry();
+    auto const lock = std::scoped_lock{r.mutex_};
+    std::erase(r.rings_, ring_.get());
+
+    auto const next = ring_->next_.load(std::memory_order_acquire);
+    auto const n = std::min<std::uint64_t>(next, ring::kSize);
+    for (auto i = next - n; i != next; ++i) {
+      r.retired_.push_back({ring_->tid_, ring_->events_[i % ring::kSize]});
+    }
+    while (r.retired_.size() > ring::kSize) {
+      r.retired_.pop_front();
+    }
+  }
+
+  ring_owner(ring_owner const&) = delete;
+  ring_owner& operator=(ring_owner const&) = delete;
+
+  std::unique_ptr<ring> ring_;
+};
+
+void write_event(std::ostream& out,
+                 bool const first,
+                 std::uint32_t const tid,
+                 event const& e) {
+  fmt::print(out,
+             R"({}{{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},)"
+             R"("dur":{:.3f}}})",
+             first ? "" : ",", e.name_, tid,
+             static_cast<double>(e.begin_) / 1000.0,
+             static_cast<double>(e.end_ - e.begin_) / 1000.0);
+}
+
+}  // namespace
+
+ring& thread_ring() {
+  thread_local auto const owner = ring_owner{};
+  return *owner.ring_;
+}
+
+void write_chrome_trace(std::ostream& out) {
+  auto& r = get_registry();
+  auto const lock = std::scoped_lock{r.mutex_};
+
+  out << R"({"displayTimeUnit":"ns","traceEvents":[)";
+  auto first = true;
+  for (auto const* x : r.rings_) {
+    auto const next = x->next_.load(std::memory_order_acquire);
+    auto const n = std::min<std::uint64_t>(next, ring::kSize);
+    for (auto i = next - n; i != next; ++i) {
+      write_event(out, first, x->tid_, x->events_[i % ring::kSize]);
+      first = false;
+    }
+  }
+  for (auto const& e : r.retired_) {
+    write_event(out, first, e.tid_, e.event_);
+    first = false;
+  }
+  out << "]}\n";
+}
+
+void clear() {
+  auto& r = get_registry();
+  auto const lock = std::scoped_lock{r.mutex_};
+  for (auto* x : r.rings_) {
+    x->next_.store(0U, std::memory_order_release);
+  }
+  r.retired_.clear();
+}
+
+}  // namespace openapi::trace
@@ -0,0 +1,74 @@
+#include "openapi/uuid.h"
+
+#include <ostream>
+
+#include "utl/verify.h"
+
+namespace openapi {
+
+namespace {
+
+constexpr auto const kInvalid = std::uint8_t{0xFFU};
+
+// Offsets of the hex pairs of each byte in the canonical form.
+constexpr auto const kPairs = std::array<std::uint8_t, 16U>{
+    0U,  2U,  4U,  6U,  9U,  11U, 14U, 16U,
+    19U, 21U, 24U, 26U, 28U, 30U, 32U, 34U};
+
+constexpr auto const kNibbles = [] {
+  auto t = std::array<std::uint8_t, 256U>{};
+  t.fill(kInvalid);
+  for (auto c = 0U; c != 10U; ++c) {
+    t['0' + c] = static_cast<std::uint8_t>(c);
+  }
+  for (auto c = 0U; c != 6U; ++c) {
+    t['a' + c] = static_cast<std::uint8_t>(10U + c);
+    t['A' + c] = static_cast<std::uint8_t>(10U + c);
+  }
+  return t;
+}();
+
+// Both hex digits of every byte value.
+constexpr auto const kHexPairs = [] {
+  constexpr auto const kHex = std::string_view{"0123456789abcdef"};
+  auto t = std::array<std::array<char, 2U>, 256U>{};
+  for (auto i = 0U; i != 256U; ++i) {
+    t[i] = {kHex[i >> 4U], kHex[i & 0xFU]};
+  }
+  return t;
+}();
+
+}  // namespace
+
+// Table lookups without a branch per character: invalid digits are
+// collected in one flag and checked once at the end.
+void parse(std::string_view s, uuid& u) {
+  utl::verify(s.size() == 36U && s[8] == '-' && s[13] == '-' &&
+                  s[18] == '-' && s[23] == '-',
+              "invalid uuid \"{}\"", s);
+  auto invalid = std::uint8_t{0U};
+  for (auto i = 0U; i != 16U; ++i) {
+    auto const hi = kNibbles[static_cast<unsigned char>(s[kPairs[i]])];
+    auto const lo = kNibbles[static_cast<unsigned char>(s[kPairs[i] + 1U])];
+    invalid |= static_cast<std::uint8_t>((hi | lo) & 0xF0U);
+    u.bytes_[i] = static_cast<std::uint8_t>((hi << 4U) | (lo & 0xFU));
+  }
+  utl::verify(invalid == 0U, "invalid uuid \"{}\"", s);
+}
+
+std::string_view format(uuid const& u, uuid_buf_t& buf) {
+  buf[8] = buf[13] = buf[18] = buf[23] = '-';
+  for (auto i = 0U; i != 16U; ++i) {
+    auto const& pair = kHexPairs[u.bytes_[i]];
+    buf[kPairs[i]] = pair[0];
+    buf[kPairs[i] + 1U] = pair[1];
+  }
+  return {buf.data(), buf.size()};
+}
+
+std::ostream& operator<<(std::ostream& out, uuid const& u) {
+  auto buf = uuid_buf_t{};
+  return out << format(u, buf);
+}
+
+}  // namespace openapi
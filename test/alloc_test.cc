@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <memory>
+#include <spanstream>
+
+#include "fmt/format.h"
+
+#include "boost/json.hpp"
+#include "boost/url/url.hpp"
+#include "boost/url/url_view.hpp"
+
+#include "openapi/alloc_probe.h"
+#include "openapi/json.h"
+
+#include "pet-api/pet-api.h"
+
+namespace json = boost::json;
+using namespace openapi;
+using namespace pet;
+
+// Exact heap allocation counts of the hot paths. JSON documents live in a
+// monotonic_resource over a stack buffer so only allocations made by our
+// own (generated) code are counted.
+
+TEST(alloc, probe) {
+  auto const probe = alloc_probe{};
+  auto const x = std::make_unique<std::uint64_t>(1U);
+  EXPECT_EQ(1U, probe.count());
+  EXPECT_EQ(sizeof(std::uint64_t), probe.bytes());
+}
+
+TEST(alloc, enum) {
+  auto buf = std::array<char, 32U>{};
+  auto out = std::ospanstream{buf};
+
+  auto const probe = alloc_probe{};
+  auto x = StatusEnum{};
+  parse("OFF", x);
+  out << x;
+  EXPECT_EQ(0U, probe.count());
+  EXPECT_EQ(StatusEnum::OFF, x);
+  EXPECT_EQ("OFF", (std::string_view{out.span().data(), out.span().size()}));
+}
+
+TEST(alloc, date_time) {
+  auto buf = date_time_buf_t{};
+
+  auto const probe = alloc_probe{};
+  auto t = date_time_t{};
+  parse("2024-06-01T08:30:00+02:00", t);
+  auto const s = format(t, buf);
+  EXPECT_EQ(0U, probe.count());
+  EXPECT_EQ("2024-06-01T08:30:00+02:00", s);
+}
+
+TEST(alloc, decode) {
+  auto buf = std::array<unsigned char, 4096U>{};
+  auto mr = json::monotonic_resource{buf.data(), buf.size()};
+
+  auto const item_json =
+      json::parse(R"({"x":"ON","y":["A","B"],"z":1})", json::storage_ptr{&mr});
+  auto const vehicle_json = json::parse(
+      R"({"id":"bus-1","status":"ON","counts":{"a":1,"b":2},)"
+      R"("lastUpdate":"2024-06-01T08:30:00Z"})",
+      json::storage_ptr{&mr});
+
+  {
+    auto const probe = alloc_probe{};
+    auto const item = json::value_to<Item>(item_json);
+    EXPECT_EQ(1U, probe.count());  // y_
+  }
+
+  {
+    auto const probe = alloc_probe{};
+    auto const vehicle = json::value_to<Vehicle>(vehicle_json);
+    EXPECT_EQ(1U, probe.count());  // counts_
+  }
+}
+
+TEST(alloc, encode) {
+  auto vehicle = Vehicle{.id_ = "bus-1"};
+  vehicle.set_status(StatusEnum::ON);
+  vehicle.set_counts(openapi::flat_map<std::int64_t>{{"a", 1}, {"b", 2}});
+  vehicle.set_lastUpdate(date_time_t{std::chrono::sys_seconds{}});
+  auto const item = Item{.x_ = StatusEnum::ON, .y_ = Pets{PetsEnum::A}};
+
+  auto buf = std::array<unsigned char, 4096U>{};
+  auto mr = json::monotonic_resource{buf.data(), buf.size()};
+
+  auto const probe = alloc_probe{};
+  auto const a = json::value_from(vehicle, json::storage_ptr{&mr});
+  auto const b = json::value_from(item, json::storage_ptr{&mr});
+  EXPECT_EQ(0U, probe.count());
+}
+
+TEST(alloc, parse_param) {
+  auto const url = boost::urls::url_view{"/items?limit=5&status=ON&ids=1,2,3"};
+  auto const query = url.params();
+  getItems_params{query};  // initializes thread locals (trace ring)
+
+  auto const probe = alloc_probe{};
+  auto const params = getItems_params{query};
+  EXPECT_EQ(1U, probe.count());  // ids_
+  EXPECT_EQ(5, params.limit_);
+  EXPECT_EQ((std::vector<std::int64_t>{1, 2, 3}), params.ids_);
+}
+
+TEST(alloc, to_url) {
+  auto params = getItems_params{};
+  params.limit_ = 5;
+  params.status_ = StatusEnum::ON;
+  params.ids_ = {1, 2, 3};
+  params.name_ = "bus";
+  params.to_url("/items");  // initializes the static defaults
+
+  auto const url_probe = alloc_probe{};
+  auto expected = boost::urls::url{"/items"};
+  expected.params().append({"limit", "5"});
+  expected.params().append({"status", "ON"});
+  expected.params().append({"ids", "1,2,3"});
+  expected.params().append({"name", "bus"});
+  auto const url_allocs = url_probe.count();
+
+  // Only the URL buffer itself may allocate.
+  auto const probe = alloc_probe{};
+  auto const url = params.to_url("/items");
+  EXPECT_EQ(url_allocs, probe.count());
+  EXPECT_EQ(expected.buffer(), url.buffer());
+}
+
+TEST(alloc, write_url) {
+  auto params = putItemTag_params{};
+  params.id_ = 7;
+  params.tag_ = "a/b";
+  params.note_ = "x y";
+  auto buf = fmt::memory_buffer{};
+  params.write_url(buf);  // initializes the static defaults
+
+  buf.clear();
+  auto const probe = alloc_probe{};
+  params.write_url(buf);
+  EXPECT_EQ(0U, probe.count());
+  EXPECT_EQ("/items/7/tags/a%2Fb?note=x%20y", fmt::to_string(buf));
+}
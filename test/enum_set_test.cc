@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+
+#include <type_traits>
+#include <vector>
+
+#include "boost/json.hpp"
+#include "boost/url.hpp"
+
+#include "openapi/enum_set.h"
+#include "openapi/json.h"
+#include "openapi/parse.h"
+
+#include "pet-api/pet-api.h"
+
+using namespace openapi;
+using namespace pet;
+
+TEST(enum_set, generated_types) {
+  static_assert(std::is_same_v<Modes, ModesEnumSet>);
+  static_assert(std::is_same_v<ModesEnumSet, enum_set<ModesEnum, 4U>>);
+  static_assert(std::is_same_v<decltype(getNearbyStops_params::status_),
+                               std::optional<StatusEnumSet>>);
+  // Enum arrays without uniqueItems stay vectors.
+  static_assert(std::is_same_v<Pets, std::vector<PetsEnum>>);
+}
+
+TEST(enum_set, set) {
+  auto s = Modes{ModesEnum::RAIL, ModesEnum::WALK, ModesEnum::RAIL};
+  EXPECT_EQ(2U, s.size());
+  EXPECT_TRUE(s.contains(ModesEnum::WALK));
+  EXPECT_FALSE(s.contains(ModesEnum::BUS));
+  EXPECT_EQ((std::vector{ModesEnum::WALK, ModesEnum::RAIL}),
+            (std::vector<ModesEnum>{s.begin(), s.end()}));
+
+  s.erase(ModesEnum::WALK);
+  EXPECT_EQ((std::vector{ModesEnum::RAIL}),
+            (std::vector<ModesEnum>{s.begin(), s.end()}));
+  EXPECT_TRUE(Modes{}.empty());
+  EXPECT_EQ(Modes{}.begin(), Modes{}.end());
+}
+
+TEST(enum_set, json) {
+  auto const stop = json::value_to<Stop>(json::parse(
+      R"({"id":"S1","pos":[49.87,8.65],"modes":["RAIL","BUS"]})"));
+  ASSERT_TRUE(stop.modes_.has_value());
+  EXPECT_EQ((Modes{ModesEnum::BUS, ModesEnum::RAIL}), *stop.modes_);
+
+  auto const jv = json::value_from(stop);
+  EXPECT_EQ(json::parse(R"(["BUS","RAIL"])"), jv.at("modes"));
+  EXPECT_EQ(json::serialize(jv).size(), serialized_size(stop));
+
+  EXPECT_ANY_THROW(json::value_to<Modes>(json::parse(R"(["BUS","BUS"])")));
+  EXPECT_ANY_THROW(json::value_to<Modes>(json::parse(R"(["CAR"])")));
+}
+
+TEST(enum_set, params) {
+  auto const params =
+      getNearbyStops_params{boost::urls::url_view{
+          "/stops/nearby?lat=1&lng=2&status=OFF,ON"}.params()};
+  ASSERT_TRUE(params.status_.has_value());
+  EXPECT_EQ((StatusEnumSet{StatusEnum::ON, StatusEnum::OFF}), *params.status_);
+
+  auto buf = fmt::memory_buffer{};
+  params.write_url(buf);
+  EXPECT_EQ("/stops/nearby?lat=1&lng=2&status=ON,OFF", fmt::to_string(buf));
+
+  EXPECT_ANY_THROW(getNearbyStops_params{boost::urls::url_view{
+      "/stops/nearby?lat=1&lng=2&status=ON,DIM"}.params()});
+  EXPECT_ANY_THROW(getNearbyStops_params{boost::urls::url_view{
+      "/stops/nearby?lat=1&lng=2&status=ON,OFF,ON"}.params()});
+}
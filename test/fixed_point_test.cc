@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <string_view>
+
+#include "boost/json.hpp"
+#include "boost/url.hpp"
+
+#include "openapi/fixed_point.h"
+#include "openapi/json.h"
+#include "openapi/parse.h"
+
+#include "pet-api/pet-api.h"
+
+using namespace openapi;
+using namespace pet;
+
+namespace {
+
+template <unsigned P>
+fixed_point<P> read(std::string_view s) {
+  auto x = fixed_point<P>{};
+  auto const [ptr, ec] = from_chars(s.data(), s.data() + s.size(), x);
+  if (ec != std::errc{} || ptr != s.data() + s.size()) {
+    throw std::runtime_error{std::string{s}};
+  }
+  return x;
+}
+
+template <unsigned P>
+std::string write(fixed_point<P> const x) {
+  auto buf = std::array<char, fixed_point<P>::kMaxChars>{};
+  auto const r = to_chars(buf.data(), buf.data() + buf.size(), x);
+  return std::string{buf.data(), r.ptr};
+}
+
+}  // namespace
+
+TEST(fixed_point, from_chars) {
+  EXPECT_EQ(49'871'234, read<6>("49.871234").value_);
+  EXPECT_EQ(-8'650'000, read<6>("-8.65").value_);
+  EXPECT_EQ(49'871'234, read<6>("4.9871234E1").value_);
+  EXPECT_EQ(49'871'234, read<6>("49871234e-6").value_);
+  EXPECT_EQ(12, read<1>("1.24").value_);
+  EXPECT_EQ(13, read<1>("1.25").value_);
+  EXPECT_EQ(-13, read<1>("-1.25").value_);
+  EXPECT_EQ(0, read<6>("0.0000001").value_);
+  EXPECT_EQ(3, read<0>("3").value_);
+  EXPECT_EQ(1, read<6>("0.000000999999999999999999999").value_);
+  EXPECT_EQ(-2'147'483'648, read<0>("-2147483648").value_);
+
+  EXPECT_ANY_THROW(read<0>("2147483648"));
+  EXPECT_ANY_THROW(read<6>("2148"));
+  EXPECT_ANY_THROW(read<6>("1e40"));
+  EXPECT_ANY_THROW(read<6>("-"));
+  EXPECT_ANY_THROW(read<6>(".e1"));
+  EXPECT_ANY_THROW(read<6>("1x"));
+}
+
+TEST(fixed_point, to_chars) {
+  EXPECT_EQ("49.871234", write(fixed_point<6>::from_raw(49'871'234)));
+  EXPECT_EQ("-8.65", write(fixed_point<6>::from_raw(-8'650'000)));
+  EXPECT_EQ("-0.000001", write(fixed_point<6>::from_raw(-1)));
+  EXPECT_EQ("12", write(fixed_point<6>::from_raw(12'000'000)));
+  EXPECT_EQ("0", write(fixed_point<2>{}));
+  EXPECT_EQ("-2147483648",
+            write(fixed_point<0>::from_raw(-2'147'483'647 - 1)));
+  EXPECT_EQ("-2.147483648",
+            write(fixed_point<9>::from_raw(-2'147'483'647 - 1)));
+}
+
+TEST(fixed_point, json) {
+  static_assert(sizeof(Position::lat_) == 4U);
+
+  auto const s =
+      R"({"lat":49.871234,"lng":-8.65,"accuracy":2.5,"track":[[1.5,2.25]]})";
+  auto const pos = json::value_to<Position>(json::parse(s));
+  EXPECT_EQ(49'871'234, pos.lat_.value_);
+  EXPECT_EQ(-8'650'000, pos.lng_.value_);
+  EXPECT_EQ(25, pos.accuracy_.value_);
+  ASSERT_TRUE(pos.track_.has_value());
+  EXPECT_EQ(2'250'000, (*pos.track_)[0][1].value_);
+
+  EXPECT_EQ(json::parse(s), json::value_from(pos));
+  EXPECT_EQ(json::serialize(json::value_from(pos)).size(),
+            serialized_size(pos));
+
+  for (auto const s : {"1.005", "-1.005", "2.675", "0.125", "1e-3"}) {
+    EXPECT_EQ(read<2>(s), json::value_to<fixed_point<2>>(json::parse(s)))
+        << s;
+  }
+  EXPECT_EQ(101, json::value_to<fixed_point<2>>(json::parse("1.005")).value_);
+  EXPECT_EQ(3, json::value_to<fixed_point<0>>(json::parse("3")).value_);
+  EXPECT_ANY_THROW(json::value_to<fixed_point<6>>(json::parse("1e10")));
+  EXPECT_ANY_THROW(json::value_to<fixed_point<6>>(json::parse("\"1\"")));
+
+  auto track = fixed_rows<fixed_point<6>, 2U>{};
+  parse_rows("[[49.871234, 8.65], [4.9E1, -8]]", track);
+  ASSERT_EQ(2U, track.size());
+  EXPECT_EQ(8'650'000, track[0][1].value_);
+  EXPECT_EQ(49'000'000, track[1][0].value_);
+}
+
+TEST(fixed_point, params) {
+  auto const params = getNearbyStops_params{
+      boost::urls::url_view{"/stops/nearby?lat=49.871234&lng=8.65"}.params()};
+  EXPECT_EQ(49'871'234, params.lat_.value_);
+  EXPECT_EQ(8'650'000, params.lng_.value_);
+  EXPECT_EQ(5, params.radius_.value_);
+
+  auto buf = fmt::memory_buffer{};
+  params.write_url(buf);
+  EXPECT_EQ("/stops/nearby?lat=49.871234&lng=8.65", fmt::to_string(buf));
+
+  EXPECT_ANY_THROW(getNearbyStops_params{
+      boost::urls::url_view{"/stops/nearby?lat=49.8x&lng=8.65"}.params()});
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "boost/json.hpp"
+
+#include "utl/verify.h"
+
+#include "openapi/serialized_size.h"
+
+namespace geo {
+
+// Mapped with x-cpp-type, encoded as [lat, lng].
+struct latlng {
+  auto operator<=>(latlng const&) const = default;
+
+  double lat_{};
+  double lng_{};
+};
+
+inline latlng tag_invoke(boost::json::value_to_tag<latlng>,
+                         boost::json::value const& jv) {
+  auto const& a = jv.as_array();
+  return {a.at(0).to_number<double>(), a.at(1).to_number<double>()};
+}
+
+inline void tag_invoke(boost::json::value_from_tag,
+                       boost::json::value& jv,
+                       latlng const& x) {
+  auto& a = jv.emplace_array();
+  a.emplace_back(x.lat_);
+  a.emplace_back(x.lng_);
+}
+
+inline std::size_t serialized_size(latlng const& x) {
+  return 3U + openapi::serialized_size(x.lat_) +
+         openapi::serialized_size(x.lng_);
+}
+
+// x-cpp-codec keeping "S<n>" stop ids as integers.
+struct stop_id_codec {
+  static void decode(boost::json::value const& jv, std::uint32_t& x) {
+    auto const s = std::string_view{jv.as_string()};
+    utl::verify(s.starts_with('S'), "invalid stop id {}", s);
+    auto const [ptr, ec] =
+        std::from_chars(s.data() + 1, s.data() + s.size(), x);
+    utl::verify(ec == std::errc{} && ptr == s.data() + s.size(),
+                "invalid stop id {}", s);
+  }
+
+  static void encode(std::uint32_t const x, boost::json::value& jv) {
+    jv = "S" + std::to_string(x);
+  }
+};
+
+}  // namespace geo
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <sstream>
+
+#include "boost/json.hpp"
+#include "boost/url/url_view.hpp"
+
+#include "openapi/metrics.h"
+
+#include "pet-api/pet-api.h"
+
+using namespace openapi;
+using namespace pet;
+
+TEST(metrics, histogram) {
+  static_assert(kMetrics || sizeof(histogram) <= 4U * sizeof(std::uint64_t));
+
+  auto h = histogram{};
+  h.record(0U);
+  h.record(1U);
+  h.record(5U);
+  h.record(7U);
+  h.record(1000U);
+
+  if constexpr (kMetrics) {
+    EXPECT_EQ(1U, h.buckets_[0U]);
+    EXPECT_EQ(1U, h.buckets_[1U]);
+    EXPECT_EQ(1U, h.buckets_[5U]);
+    EXPECT_EQ(1U, h.buckets_[7U]);
+    EXPECT_EQ(1U, h.buckets_[histogram::bucket(1000U)]);
+    EXPECT_EQ(5U, h.count_);
+    EXPECT_EQ(1013U, h.sum_);
+  } else {
+    EXPECT_EQ(0U, h.count_);
+  }
+}
+
+TEST(metrics, histogram_buckets) {
+  EXPECT_EQ(960U, histogram::lower_bound(histogram::bucket(1000U)));
+  EXPECT_EQ(1023U, histogram::upper_bound(histogram::bucket(1000U)));
+
+  for (auto v = std::uint64_t{0U}; v < 100'000U; v += 1U + v / 64U) {
+    auto const i = histogram::bucket(v);
+    ASSERT_LE(histogram::lower_bound(i), v);
+    ASSERT_GE(histogram::upper_bound(i), v);
+    // Exact below 8, otherwise at most 1/8 of the lower bound wide.
+    auto const width =
+        histogram::upper_bound(i) - histogram::lower_bound(i) + 1U;
+    if (v < histogram::kSubBuckets) {
+      ASSERT_EQ(1U, width);
+    } else {
+      ASSERT_LE(width * histogram::kSubBuckets, histogram::lower_bound(i));
+    }
+  }
+  auto const max = (std::uint64_t{1U} << histogram::kMaxBits) - 1U;
+  EXPECT_EQ(histogram::kBuckets - 1U, histogram::bucket(max));
+  EXPECT_EQ(max, histogram::upper_bound(histogram::kBuckets - 1U));
+}
+
+TEST(metrics, generated) {
+  auto& m = putVehicle_metrics;
+  auto const before = m.request_bytes_.count_.load();
+  auto const errors_before = m.errors_.load();
+
+  auto const body = std::string_view{R"({"id":"bus-1","speed":3.5})"};
+  auto const vehicle = decode_putVehicle_request(body);
+  EXPECT_EQ(3.5, vehicle.speed());
+  EXPECT_ANY_THROW(decode_putVehicle_request(R"({"speed":3.5})"));
+
+  auto const json = encode_putVehicle_response(vehicle);
+  EXPECT_EQ(boost::json::parse(body), boost::json::parse(json));
+
+  EXPECT_ANY_THROW(
+      getItems_params{boost::urls::url_view{"/items?status=UNKNOWN"}.params()});
+
+  if constexpr (kMetrics) {
+    EXPECT_EQ(before + 2U, m.request_bytes_.count_);
+    EXPECT_EQ(errors_before + 1U, m.errors_);
+    EXPECT_EQ(1U, m.response_bytes_.count_);
+    EXPECT_EQ(json.size(), m.response_bytes_.sum_);
+    EXPECT_LE(1U, getItems_metrics.errors_);
+  }
+
+  auto out = std::stringstream{};
+  write_prometheus(out, all_metrics());
+  auto const text = out.str();
+  EXPECT_NE(std::string::npos,
+            text.find("# TYPE openapi_params_parse_nanoseconds histogram\n"));
+  EXPECT_NE(std::string::npos,
+            text.find("openapi_request_bytes_bucket{operation=\"putVehicle\","
+                      "le=\"+Inf\"}"));
+  EXPECT_NE(std::string::npos,
+            text.find("openapi_errors_total{operation=\"getItems\"}"));
+  if constexpr (kMetrics) {
+    // Only non-empty buckets are written.
+    EXPECT_EQ(std::string::npos,
+              text.find("openapi_request_bytes_bucket{operation=\"putVehicle\","
+                        "le=\"0\"}"));
+  }
+}
@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "boost/json.hpp"
+#include "boost/url.hpp"
+
+#include "openapi/json.h"
+#include "openapi/parse.h"
+
+#include "pet-api/pet-api.h"
+
+using namespace openapi;
+using namespace pet;
+
+TEST(numeric_types, generated_types) {
+  static_assert(std::is_same_v<decltype(Stop::occupancy_),
+                               std::optional<std::uint8_t>>);
+  static_assert(
+      std::is_same_v<decltype(Stop::level_), std::optional<std::int32_t>>);
+  static_assert(
+      std::is_same_v<decltype(Stop::elevation_), std::optional<float>>);
+  static_assert(std::is_same_v<decltype(Stop::platforms_),
+                               std::optional<std::vector<std::uint16_t>>>);
+  static_assert(
+      std::is_same_v<decltype(getNearbyStops_params::limit_), std::uint16_t>);
+}
+
+TEST(numeric_types, json_roundtrip) {
+  auto const jv = json::parse(
+      R"({"id":"S1","pos":[49.87,8.65],"occupancy":100,"level":-2,)"
+      R"("elevation":0.5,"platforms":[1,999]})");
+  auto const stop = json::value_to<Stop>(jv);
+  EXPECT_EQ(100U, stop.occupancy_);
+  EXPECT_EQ(-2, stop.level_);
+  EXPECT_EQ(0.5F, stop.elevation_);
+  EXPECT_EQ((std::vector<std::uint16_t>{1U, 999U}), stop.platforms_);
+  EXPECT_EQ(stop, json::value_to<Stop>(json::value_from(stop)));
+  EXPECT_EQ(json::serialize(jv).size(), serialized_size(stop));
+}
+
+TEST(numeric_types, json_range) {
+  auto const decode = [](char const* occupancy) {
+    return json::value_to<Stop>(json::parse(
+        std::string{R"({"id":"S1","pos":[0,0],"occupancy":)"} + occupancy +
+        "}"));
+  };
+  EXPECT_NO_THROW(decode("0"));
+  EXPECT_ANY_THROW(decode("101"));  // schema maximum
+  EXPECT_ANY_THROW(decode("256"));  // std::uint8_t
+  EXPECT_ANY_THROW(decode("-1"));
+
+  EXPECT_ANY_THROW(json::value_to<Stop>(
+      json::parse(R"({"id":"S1","pos":[0,0],"level":2147483648})")));
+
+  auto stop = decode("50");
+  apply_patch(stop, json::parse(R"({"occupancy":100})"));
+  EXPECT_EQ(100U, stop.occupancy_);
+  EXPECT_ANY_THROW(apply_patch(stop, json::parse(R"({"occupancy":200})")));
+  EXPECT_EQ(100U, stop.occupancy_);
+}
+
+TEST(numeric_types, params) {
+  auto const parse = [](char const* url) {
+    return getNearbyStops_params{boost::urls::url_view{url}.params()};
+  };
+  EXPECT_EQ(20U, parse("/stops/nearby?lat=1&lng=2").limit_);
+  EXPECT_EQ(500U, parse("/stops/nearby?lat=1&lng=2&limit=500").limit_);
+  EXPECT_ANY_THROW(parse("/stops/nearby?lat=1&lng=2&limit=0"));
+  EXPECT_ANY_THROW(parse("/stops/nearby?lat=1&lng=2&limit=501"));
+  EXPECT_ANY_THROW(parse("/stops/nearby?lat=1&lng=2&limit=70000"));
+  EXPECT_ANY_THROW(parse("/stops/nearby?lat=1&lng=2&limit=5x"));
+
+  auto buf = fmt::memory_buffer{};
+  parse("/stops/nearby?lat=1&lng=2&limit=42").write_url(buf);
+  EXPECT_EQ("/stops/nearby?lat=1&lng=2&limit=42", fmt::to_string(buf));
+}
+
+TEST(numeric_types, check_range) {
+  EXPECT_EQ(7, (check_range<0, 10>(7, "x")));
+  EXPECT_ANY_THROW((check_range<0, 10>(11, "x")));
+  EXPECT_ANY_THROW((check_range<0, no_bound{}>(std::int64_t{-1}, "x")));
+  EXPECT_NO_THROW((check_range<0.5, 1>(0.75F, "x")));
+  EXPECT_ANY_THROW((check_range<0.5, 1>(0.25F, "x")));
+  EXPECT_NO_THROW((check_range<1, 2>(std::optional<int>{}, "x")));
+}
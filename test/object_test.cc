@@ -1,9 +1,18 @@
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
 #include "yaml-cpp/yaml.h"
 
 #include "cista/hash.h"
 
+#include "fmt/format.h"
+
 #include "boost/json.hpp"
 #include "boost/url.hpp"
 
@@ -24,4 +33,392 @@ TEST(openapi, roundtrip) {
   auto const v = json::parse(json);
   auto const vx = json::value_to<Item>(v);
   EXPECT_EQ(val, vx);
-}
\ No newline at end of file
+}
+
+TEST(openapi, presence_bitmask) {
+  auto val = Vehicle{.id_ = "bus-1"};
+  val.set_speed(12.5);
+  val.set_status(StatusEnum::ON);
+  EXPECT_TRUE(val.has_speed());
+  EXPECT_FALSE(val.has_bearing());
+
+  auto const json = json::serialize(json::value_from(val));
+  auto const v = json::parse(json);
+  EXPECT_FALSE(v.as_object().contains("bearing"));
+
+  auto const vx = json::value_to<Vehicle>(v);
+  EXPECT_EQ(val, vx);
+  EXPECT_EQ(12.5, vx.speed());
+  EXPECT_EQ(StatusEnum::ON, vx.status());
+
+  auto reset = vx;
+  reset.reset_speed();
+  reset.reset_status();
+  EXPECT_FALSE(reset.has_speed());
+  EXPECT_EQ((Vehicle{.id_ = "bus-1"}), reset);
+}
+
+TEST(openapi, flat_map_additional_properties) {
+  auto const v = json::parse(
+      R"({"id":"bus-1","attributes":{"wheelchair":"yes","bikes":"no"},)"
+      R"("counts":{"b":3,"a":1}})");
+  auto const vx = json::value_to<Vehicle>(v);
+
+  ASSERT_TRUE(vx.has_attributes());
+  EXPECT_EQ((Attributes{{"bikes", "no"}, {"wheelchair", "yes"}}),
+            vx.attributes());
+  EXPECT_EQ("bikes", vx.attributes().begin()->first);
+
+  ASSERT_TRUE(vx.has_counts());
+  ASSERT_EQ(2U, vx.counts().size());
+  EXPECT_EQ(1, vx.counts().find("a")->second);
+  EXPECT_EQ(3, vx.counts().find("b")->second);
+
+  EXPECT_EQ(vx, json::value_to<Vehicle>(json::value_from(vx)));
+}
+
+TEST(openapi, columns) {
+  auto const items = getItems_response{
+      Item{.x_ = StatusEnum::ON, .y_ = Pets{PetsEnum::A}, .z_ = 1},
+      Item{.x_ = StatusEnum::OFF, .y_ = Pets{}},
+      Item{.x_ = StatusEnum::ON, .y_ = Pets{PetsEnum::B}, .z_ = 3}};
+
+  auto cols = ItemColumns{};
+  for (auto const& x : items) {
+    cols.push_back(x);
+  }
+  ASSERT_EQ(3U, cols.size());
+  EXPECT_EQ((std::vector<std::int64_t>{1, 0, 3}), cols.z_);
+  EXPECT_EQ((std::vector<bool>{true, false, true}), cols.z_valid_);
+
+  auto const json = json::serialize(json::value_from(cols));
+  EXPECT_EQ(json::serialize(json::value_from(items)), json);
+
+  auto const decoded = json::value_to<ItemColumns>(json::parse(json));
+  EXPECT_EQ(cols, decoded);
+
+  auto const negative = json::parse(R"([{"x":"ON","y":[],"z":-1}])");
+  EXPECT_ANY_THROW(json::value_to<Item>(negative.as_array()[0]));
+  EXPECT_ANY_THROW(json::value_to<ItemColumns>(negative));
+
+  auto sum = std::int64_t{0};
+  auto i = 0U;
+  for (auto const row : decoded) {
+    if (row.has_z()) {
+      sum += row.z();
+    }
+    EXPECT_EQ(items[i++], row.get());
+  }
+  EXPECT_EQ(4, sum);
+}
+
+TEST(openapi, field_projection) {
+  auto vehicle = Vehicle{.id_ = "bus-1"};
+  vehicle.set_speed(12.5);
+  vehicle.set_status(StatusEnum::OFF);
+  auto const trip = Trip{
+      .id_ = "t1",
+      .vehicle_ = vehicle,
+      .items_ = std::vector{
+          Item{.x_ = StatusEnum::ON, .y_ = Pets{PetsEnum::A}, .z_ = 1}}};
+
+  auto f = TripFields{};
+  parse("id,vehicle.status,items.x,items.z", f);
+  EXPECT_EQ(
+      R"({"id":"t1","vehicle":{"status":"OFF"},"items":[{"x":"ON","z":1}]})",
+      json::serialize(to_json(trip, f)));
+
+  parse("vehicle.status,vehicle", f);
+  EXPECT_EQ(json::value_from(vehicle),
+            to_json(trip, f).as_object().at("vehicle"));
+
+  EXPECT_EQ(json::value_from(trip), to_json(trip, TripFields::all()));
+  EXPECT_ANY_THROW(parse("id.x", f));
+  EXPECT_ANY_THROW(parse("unknown", f));
+}
+
+TEST(openapi, field_projection_recursive) {
+  auto const tree = Node{
+      .name_ = "a",
+      .children_ = std::vector{
+          Node{.name_ = "b", .children_ = std::vector{Node{.name_ = "c"}}}}};
+
+  auto f = NodeFields{};
+  parse("name,children.name", f);
+  EXPECT_EQ(R"({"name":"a","children":[{"name":"b"}]})",
+            json::serialize(to_json(tree, f)));
+
+  auto const copy = f;
+  EXPECT_EQ(f, copy);
+  parse("children.children", f);
+  EXPECT_NE(f, copy);
+  EXPECT_EQ(R"({"children":[{"children":[{"name":"c"}]}]})",
+            json::serialize(to_json(tree, f)));
+
+  parse("children.name,children", f);
+  EXPECT_EQ(json::value_from(tree).as_object().at("children"),
+            to_json(tree, f).as_object().at("children"));
+  EXPECT_EQ(json::value_from(tree), to_json(tree, NodeFields::all()));
+}
+
+TEST(openapi, lazy) {
+  auto const l = lazy<Vehicle>{
+      R"({"bearing": 90, "id": "bus-\"1\"", "counts": {"a": [1, {"b": 2}]},)"
+      R"( "status": "ON", "xy": null})"};
+  EXPECT_EQ("bus-\"1\"", l.id());
+  EXPECT_EQ(StatusEnum::ON, l.status());
+  EXPECT_FALSE(l.speed().has_value());
+  EXPECT_EQ(3U, l.decoded_.count());
+
+  auto expected = Vehicle{.id_ = "bus-\"1\""};
+  expected.set_bearing(90);
+  expected.set_status(StatusEnum::ON);
+  EXPECT_ANY_THROW(l.counts());
+  EXPECT_ANY_THROW(l.get());
+
+  auto const ok =
+      VehicleLazy{R"({"bearing":90,"id":"bus-\"1\"","status":"ON"})"};
+  EXPECT_EQ(expected, ok.get());
+
+  EXPECT_ANY_THROW(VehicleLazy{R"({"id": "x",})"});
+  EXPECT_ANY_THROW(VehicleLazy{R"({"id": "x"} x)"});
+  EXPECT_ANY_THROW(VehicleLazy{R"({"id": 01})"});
+  EXPECT_ANY_THROW(VehicleLazy{R"(["id"])"});
+  EXPECT_ANY_THROW(VehicleLazy{R"({"id": "x)"});
+  EXPECT_THROW(VehicleLazy{R"({"speed": 1})"}.id(), std::exception);
+
+  auto const out_of_range = VehicleLazy{R"({"id":"x","bearing":361})"};
+  EXPECT_EQ("x", out_of_range.id());
+  EXPECT_ANY_THROW(out_of_range.bearing());
+  EXPECT_ANY_THROW(out_of_range.get());
+}
+
+TEST(openapi, merge_patch) {
+  auto vehicle = Vehicle{.id_ = "bus-1"};
+  vehicle.set_speed(12.5);
+  vehicle.set_status(StatusEnum::OFF);
+  vehicle.set_counts(openapi::flat_map<std::int64_t>{{"a", 1}, {"b", 2}});
+  auto const old = Trip{.id_ = "t1", .vehicle_ = vehicle};
+
+  auto cur = old;
+  cur.vehicle_->set_status(StatusEnum::ON);
+  cur.vehicle_->reset_speed();
+  cur.vehicle_->set_counts(
+      openapi::flat_map<std::int64_t>{{"b", 2}, {"c", 3}});
+  cur.items_ = std::vector{Item{.x_ = StatusEnum::ON, .y_ = {}, .z_ = 1}};
+
+  auto patch = json::object{};
+  diff(old, cur, patch);
+  EXPECT_EQ(json::parse(R"({
+    "vehicle": {"speed": null, "status": "ON", "counts": {"a": null, "c": 3}},
+    "items": [{"x": "ON", "y": [], "z": 1}]
+  })"),
+            json::value{patch});
+
+  auto patched = old;
+  apply_patch(patched, patch);
+  EXPECT_EQ(cur, patched);
+
+  auto empty = json::object{};
+  diff(cur, cur, empty);
+  EXPECT_TRUE(empty.empty());
+
+  EXPECT_ANY_THROW(apply_patch(patched, json::parse(R"({"id": null})")));
+
+  // A rejected patch leaves the target unchanged.
+  EXPECT_ANY_THROW(apply_patch(
+      patched, json::parse(R"({"id": "t2", "vehicle": {"status": "DIM"}})")));
+  EXPECT_EQ(cur, patched);
+}
+
+TEST(openapi, merge_patch_free_form_object) {
+  using map_t = std::map<std::string, std::int64_t>;
+  auto patch = json::object{};
+  diff_member(patch, map_t{{"a", 1}, {"b", 2}}, map_t{{"b", 3}, {"c", 4}},
+              "m");
+  EXPECT_EQ(json::parse(R"({"m": {"a": null, "b": 3, "c": 4}})"),
+            json::value{patch});
+
+  auto unchanged = json::object{};
+  diff_member(unchanged, map_t{{"a", 1}}, map_t{{"a", 1}}, "m");
+  EXPECT_TRUE(unchanged.empty());
+}
+
+TEST(openapi, one_of_discriminator) {
+  auto const itinerary = json::value_to<Itinerary>(json::parse(R"({"legs": [
+    {"distance": 250.0, "mode": "WALK"},
+    {"mode": "BUS", "route": "M41"},
+    {"route": "S1", "headsign": "Ahrensfelde", "mode": "RAIL"},
+    {"mode": "FlexLeg"}
+  ]})"));
+
+  ASSERT_EQ(4U, itinerary.legs_.size());
+  auto const& walk = std::get<WalkLeg>(itinerary.legs_[0]);
+  EXPECT_EQ("WALK", walk.mode_);
+  EXPECT_EQ(250.0, walk.distance_);
+  EXPECT_EQ("M41", std::get<TransitLeg>(itinerary.legs_[1]).route_);
+  EXPECT_EQ("S1", std::get<TransitLeg>(itinerary.legs_[2]).route_);
+  EXPECT_EQ("RAIL", std::get<TransitLeg>(itinerary.legs_[2]).mode_);
+  EXPECT_TRUE(std::holds_alternative<FlexLeg>(itinerary.legs_[3]));
+
+  auto const encoded = json::serialize(json::value_from(itinerary));
+  EXPECT_EQ(encoded.size(), serialized_size(itinerary));
+  EXPECT_EQ(itinerary, json::value_to<Itinerary>(json::parse(encoded)));
+
+  // Tags round-trip. Alternatives without the property get their tag.
+  EXPECT_EQ(json::parse(R"({"mode":"RAIL","route":"S1",
+                            "headsign":"Ahrensfelde"})"),
+            json::value_from(itinerary.legs_[2]));
+  EXPECT_EQ(json::parse(R"({"mode":"FlexLeg"})"),
+            json::value_from(itinerary.legs_[3]));
+
+  EXPECT_ANY_THROW(json::value_to<Leg>(json::parse(R"({"route":"S1"})")));
+  EXPECT_ANY_THROW(
+      json::value_to<Leg>(json::parse(R"({"mode":"FERRY","route":"F1"})")));
+}
+
+TEST(openapi, one_of_ambiguous_tag) {
+  auto const gen = [](std::string_view mapping) {
+    auto const spec = YAML::Load(fmt::format(R"(
+components:
+  schemas:
+    A:
+      type: object
+      properties:
+        x:
+          type: string
+    B:
+      type: object
+      properties:
+        kind:
+          type: string
+    AorB:
+      oneOf:
+        - $ref: '#/components/schemas/A'
+        - $ref: '#/components/schemas/B'
+      discriminator:
+        propertyName: kind
+        mapping:
+{})",
+                                             mapping));
+    auto header = std::stringstream{};
+    auto source = std::stringstream{};
+    openapi::write_types(spec, "x.h", header, source, std::nullopt);
+  };
+
+  EXPECT_NO_THROW(gen("          A1: '#/components/schemas/A'"));
+  // Several tags for an alternative that cannot store which one it was.
+  EXPECT_ANY_THROW(gen("          A1: '#/components/schemas/A'\n"
+                       "          A2: '#/components/schemas/A'"));
+  // Fine if the alternative keeps the tag in its own property.
+  EXPECT_NO_THROW(gen("          B1: '#/components/schemas/B'\n"
+                      "          B2: '#/components/schemas/B'"));
+}
+
+TEST(openapi, all_of_redeclared_member) {
+  auto const gen = [](std::string_view type) {
+    auto const spec = YAML::Load(fmt::format(R"(
+components:
+  schemas:
+    Base:
+      type: object
+      properties:
+        a:
+          type: string
+    Derived:
+      allOf:
+        - $ref: '#/components/schemas/Base'
+        - type: object
+          properties:
+            a:
+              type: {}
+)",
+                                             type));
+    auto header = std::stringstream{};
+    auto source = std::stringstream{};
+    openapi::write_types(spec, "x.h", header, source, std::nullopt);
+  };
+
+  EXPECT_NO_THROW(gen("string"));
+  EXPECT_ANY_THROW(gen("integer"));
+}
+
+TEST(openapi, all_of) {
+  auto const dog = json::value_to<Dog>(json::parse(
+      R"({"name":"Rex","tag":"good","breed":"Beagle","weight":12.5})"));
+  EXPECT_EQ("Rex", dog.name_);
+  EXPECT_EQ("good", dog.tag());
+  EXPECT_FALSE(dog.has_status());
+  EXPECT_EQ("Beagle", dog.breed_);
+  EXPECT_EQ(12.5, dog.weight());
+  EXPECT_EQ(json::parse(R"({"name": "Rex", "tag": "good", "breed": "Beagle",
+                            "weight": 12.5})"),
+            json::value_from(dog));
+
+  Pet const pet = dog;
+  EXPECT_EQ((Pet{.name_ = "Rex", .tag_ = "good"}), pet);
+
+  EXPECT_ANY_THROW(json::value_to<Dog>(json::parse(R"({"name":"Rex"})")));
+}
+
+TEST(openapi, format_defaults) {
+  auto const t = Timetable{};
+  EXPECT_EQ(date_t{std::chrono::year{2024} / 12 / 15}, t.validFrom_);
+  EXPECT_EQ(json::value{"0190a3c2-7b1e-7c4d-9f2a-5e8b6d1c3a40"},
+            json::value_from(t.feed_));
+  ASSERT_EQ(3U, t.route_.size());
+  EXPECT_EQ(3'850'000, t.route_[0][0].value_);
+  EXPECT_EQ(R"(see "C:\timetables")", t.note_);
+
+  auto const gen = [](std::string_view format, std::string_view value) {
+    auto const spec = YAML::Load(fmt::format(R"(
+components:
+  schemas:
+    Timetable:
+      type: object
+      properties:
+        x:
+          type: string
+          format: {}
+          default: '{}'
+)",
+                                             format, value));
+    auto header = std::stringstream{};
+    auto source = std::stringstream{};
+    openapi::write_types(spec, "x.h", header, source, std::nullopt);
+  };
+  EXPECT_NO_THROW(gen("date", "2024-12-15"));
+  EXPECT_ANY_THROW(gen("date", "2024-13-15"));
+  EXPECT_ANY_THROW(gen("uuid", "0190a3c2"));
+  EXPECT_ANY_THROW(gen("date-time", "today"));
+}
+
+TEST(openapi, cpp_type) {
+  auto const stop = json::value_to<Stop>(
+      json::parse(R"({"id":"S17","parent":"S3","pos":[49.87,8.65]})"));
+  EXPECT_EQ(17U, stop.id_);
+  EXPECT_EQ(3U, stop.parent_);
+  EXPECT_EQ((geo::latlng{49.87, 8.65}), stop.pos_);
+  EXPECT_EQ(json::parse(R"({"id":"S17","parent":"S3","pos":[49.87,8.65]})"),
+            json::value_from(stop));
+  EXPECT_EQ(json::serialize(json::value_from(stop)).size(),
+            serialized_size(stop));
+  EXPECT_ANY_THROW(json::value_to<Stop>(
+      json::parse(R"({"id":"","pos":[49.87,8.65]})")));
+
+  auto moved = stop;
+  moved.parent_ = std::nullopt;
+  moved.pos_.lat_ = 50.0;
+  auto patch = json::object{};
+  diff(stop, moved, patch);
+  EXPECT_EQ(json::parse(R"({"parent":null,"pos":[50.0,8.65]})"),
+            json::value{patch});
+
+  auto patched = stop;
+  apply_patch(patched, json::parse(R"({"id":"S18","pos":[50.0,8.65]})"));
+  EXPECT_EQ(18U, patched.id_);
+  EXPECT_EQ(50.0, patched.pos_.lat_);
+
+  EXPECT_ANY_THROW(json::value_to<Stop>(
+      json::parse(R"({"id":"X17","pos":[49.87,8.65]})")));
+}
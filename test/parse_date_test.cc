@@ -1,9 +1,18 @@
 #include "gtest/gtest.h"
 
+#include <optional>
+#include <type_traits>
+
 #include "date/date.h"
 
+#include "boost/json.hpp"
+#include "boost/url.hpp"
+
+#include "openapi/json.h"
 #include "openapi/parse.h"
 
+#include "pet-api/pet-api.h"
+
 using namespace std::chrono_literals;
 using namespace date;
 using namespace openapi;
@@ -34,4 +43,50 @@ TEST(openapi, date) {
   parse("2009-06-30T20:30:00.000Z", d);
   EXPECT_EQ(date::sys_days{2009_y / June / 30} + 20h + 30min, d.time_);
   EXPECT_EQ(0h, d.offset_);
-}
\ No newline at end of file
+}
+
+TEST(openapi, calendar_date) {
+  auto d = date_t{};
+  parse("2024-02-29", d);
+  EXPECT_EQ(date::sys_days{2024_y / February / 29}, std::chrono::sys_days{d});
+  EXPECT_EQ(19782, d.days_);
+
+  auto buf = date_buf_t{};
+  EXPECT_EQ("2024-02-29", format(d, buf));
+  EXPECT_EQ("1970-01-01", format(date_t{}, buf));
+  EXPECT_EQ("0099-12-31",
+            format(date_t{std::chrono::year{99} / 12 / 31}, buf));
+
+  EXPECT_ANY_THROW(parse("2023-02-29", d));
+  EXPECT_ANY_THROW(parse("2024-13-01", d));
+  EXPECT_ANY_THROW(parse("2024-1-01", d));
+  EXPECT_ANY_THROW(parse("2024-01-01T00:00Z", d));
+  EXPECT_ANY_THROW(parse("2024/01/01", d));
+}
+
+TEST(openapi, calendar_date_api) {
+  static_assert(sizeof(date_t) == 4U);
+  static_assert(std::is_same_v<decltype(pet::ServiceDay::date_), date_t>);
+  static_assert(std::is_same_v<decltype(pet::getServiceDays_params::to_),
+                               std::optional<date_t>>);
+
+  auto const jv = boost::json::parse(
+      R"({"date":"2024-06-01","exceptions":["2024-12-25","2024-12-26"]})");
+  auto const day = boost::json::value_to<pet::ServiceDay>(jv);
+  EXPECT_EQ(date_t{2024_y / June / 1}, day.date_);
+  EXPECT_EQ(jv, boost::json::value_from(day));
+  EXPECT_EQ(boost::json::serialize(jv).size(), serialized_size(day));
+
+  auto const params = pet::getServiceDays_params{
+      boost::urls::url_view{"/calendar?from=2024-06-01&to=2024-06-30"}
+          .params()};
+  EXPECT_EQ(date_t{2024_y / June / 1}, params.from_);
+  EXPECT_EQ(date_t{2024_y / June / 30}, params.to_);
+
+  auto buf = fmt::memory_buffer{};
+  params.write_url(buf);
+  EXPECT_EQ("/calendar?from=2024-06-01&to=2024-06-30", fmt::to_string(buf));
+
+  EXPECT_ANY_THROW(pet::getServiceDays_params{
+      boost::urls::url_view{"/calendar?from=2024-06-31"}.params()});
+}
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <type_traits>
+
+#include "boost/json.hpp"
+
+#include "openapi/json.h"
+#include "openapi/parse.h"
+#include "openapi/polyline.h"
+
+#include "pet-api/pet-api.h"
+
+using namespace openapi;
+using namespace pet;
+
+namespace {
+
+// Example from the encoded polyline algorithm format documentation.
+constexpr auto const kEncoded = std::string_view{"_p~iF~ps|U_ulLnnqC_mqNvxq`@"};
+
+polyline<5U> example() {
+  auto p = polyline<5U>{};
+  p.push_back({38.5, -120.2});
+  p.push_back({40.7, -120.95});
+  p.push_back({43.252, -126.453});
+  return p;
+}
+
+}  // namespace
+
+TEST(polyline, encode_decode) {
+  auto s = std::string{};
+  encode_polyline(example(), s);
+  EXPECT_EQ(kEncoded, s);
+  EXPECT_EQ(kEncoded.size(), encoded_size(example()));
+
+  auto p = polyline<5U>{};
+  decode_polyline(kEncoded, p);
+  EXPECT_EQ(example(), p);
+
+  decode_polyline("", p);
+  EXPECT_TRUE(p.empty());
+
+  EXPECT_ANY_THROW(decode_polyline("_p~iF", p));
+  EXPECT_ANY_THROW(decode_polyline("_p~iF~ps|", p));
+  EXPECT_ANY_THROW(decode_polyline("_p~iF ps|U", p));
+  EXPECT_ANY_THROW(decode_polyline("~~~~~~~~~~~~~~~??", p));
+}
+
+TEST(polyline, json) {
+  static_assert(std::is_same_v<decltype(Shape::points_), polyline<5U>>);
+  static_assert(
+      std::is_same_v<decltype(Shape::detail_), std::optional<polyline<6U>>>);
+
+  auto const shape = json::value_to<Shape>(json::parse(
+      R"({"points":"_p~iF~ps|U_ulLnnqC_mqNvxq`@","detail":"\\?"})"));
+  EXPECT_EQ(example(), shape.points_);
+  ASSERT_TRUE(shape.detail_.has_value());
+  ASSERT_EQ(1U, shape.detail_->size());
+  EXPECT_EQ(-15, (*shape.detail_)[0][0].value_);
+
+  auto const jv = json::value_from(shape);
+  EXPECT_EQ(kEncoded, std::string_view{jv.at("points").as_string()});
+  EXPECT_EQ(json::serialize(jv).size(), serialized_size(shape));
+
+  auto buf = fmt::memory_buffer{};
+  format_param(buf, example());
+  auto p = polyline<5U>{};
+  parse(fmt::to_string(buf), p);
+  EXPECT_EQ(example(), p);
+}
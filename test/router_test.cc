@@ -0,0 +1,139 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <type_traits>
+
+#include "boost/url/url_view.hpp"
+
+#include "fmt/format.h"
+
+#include "openapi/missing_param_exception.h"
+
+#include "utl/overloaded.h"
+
+#include "pet-api/pet-api.h"
+
+using namespace openapi;
+using namespace pet;
+
+TEST(router, match) {
+  auto const m = match_route(http_method::kGet, "/items");
+  EXPECT_EQ(route_status::kFound, m.status_);
+  EXPECT_EQ(operation_id::getItems, m.op_);
+
+  auto const item = match_route(http_method::kGet, "/items/42");
+  EXPECT_EQ(route_status::kFound, item.status_);
+  EXPECT_EQ(operation_id::getItem, item.op_);
+  EXPECT_EQ("42", item.path_params_[0]);
+
+  auto const count = match_route(http_method::kGet, "/items/count");
+  EXPECT_EQ(route_status::kFound, count.status_);
+  EXPECT_EQ(operation_id::countItems, count.op_);
+
+  auto const tag = match_route(http_method::kPut, "/items/count/tags/a%2Fb");
+  EXPECT_EQ(route_status::kFound, tag.status_);
+  EXPECT_EQ(operation_id::putItemTag, tag.op_);
+  EXPECT_EQ("count", tag.path_params_[0]);
+  EXPECT_EQ("a%2Fb", tag.path_params_[1]);
+
+  EXPECT_EQ(route_status::kMethodNotAllowed,
+            match_route(http_method::kGet, "/vehicles").status_);
+  EXPECT_EQ(route_status::kNotFound,
+            match_route(http_method::kGet, "/items/42/tags").status_);
+  EXPECT_EQ(route_status::kNotFound,
+            match_route(http_method::kGet, "/items/").status_);
+  EXPECT_EQ(route_status::kNotFound,
+            match_route(http_method::kGet, "items").status_);
+  EXPECT_EQ(route_status::kNotFound,
+            match_route(http_method::kGet, "").status_);
+}
+
+TEST(router, dispatch) {
+  auto const handle = [](std::string_view method, std::string_view target) {
+    auto const url = boost::urls::url_view{target};
+    auto m = http_method{};
+    parse(method, m);
+    return dispatch(
+        match_route(m, url.encoded_path()),
+        utl::overloaded{
+            [](route_status const s, boost::urls::params_view const&) {
+              return std::string{s == route_status::kNotFound ? "404"
+                                                              : "405"};
+            },
+            [](getItem_path const& p, boost::urls::params_view const& q) {
+              auto const params = getItem_params{q, p};
+              return "item " + std::to_string(params.id_);
+            },
+            [](putItemTag_path const& p, boost::urls::params_view const& q) {
+              auto const params = putItemTag_params{q, p};
+              return "tag " + std::to_string(params.id_) + " " +
+                     params.tag_ + " " + params.note_.value_or("-");
+            },
+            [](auto const&, boost::urls::params_view const&) {
+              return std::string{"other"};
+            }},
+        url.params());
+  };
+
+  EXPECT_EQ("item 7", handle("GET", "/items/7"));
+  EXPECT_EQ("tag 7 a/b x", handle("PUT", "/items/7/tags/a%2Fb?note=x"));
+  EXPECT_EQ("tag 7 b -", handle("PUT", "/items/7/tags/b"));
+  EXPECT_EQ("other", handle("GET", "/items?limit=3"));
+  EXPECT_EQ("405", handle("DELETE", "/items/7"));
+  EXPECT_EQ("404", handle("GET", "/pets"));
+  EXPECT_ANY_THROW(handle("BREW", "/items"));
+}
+
+TEST(router, missing_path_param) {
+  static_assert(!std::is_constructible_v<getItem_params,
+                                         boost::urls::params_view const&>);
+  static_assert(
+      std::is_constructible_v<getItems_params, boost::urls::params_view const&>);
+
+  auto const q = boost::urls::url_view{"/items/"}.params();
+  EXPECT_THROW(getItem_params(q, getItem_path{}),
+               openapi::missing_param_exception);
+  EXPECT_THROW(putItemTag_params(q, putItemTag_path{.id_ = "1"}),
+               openapi::missing_param_exception);
+  EXPECT_EQ(1, getItem_params(q, getItem_path{.id_ = "1"}).id_);
+}
+
+TEST(router, write_url) {
+  auto tag = putItemTag_params{};
+  tag.id_ = 7;
+  tag.tag_ = "a/b c";
+  tag.note_ = "x&y=z";
+
+  auto url = std::string{};
+  tag.write_url(url);
+  EXPECT_EQ("/items/7/tags/a%2Fb%20c?note=x%26y%3Dz", url);
+
+  auto const parsed = boost::urls::url_view{url};
+  auto const m = match_route(http_method::kPut, parsed.encoded_path());
+  ASSERT_EQ(operation_id::putItemTag, m.op_);
+  auto const roundtrip =
+      putItemTag_params{parsed.params(), putItemTag_path{m.path_params_[0],
+                                                         m.path_params_[1]}};
+  EXPECT_EQ(tag.id_, roundtrip.id_);
+  EXPECT_EQ(tag.tag_, roundtrip.tag_);
+
+  auto items = getItems_params{};
+  items.limit_ = 5;
+  items.ids_ = {1, 2};
+  auto buf = fmt::memory_buffer{};
+  items.write_url(buf);
+  EXPECT_EQ("/items?limit=5&ids=1,2", fmt::to_string(buf));
+
+  url.clear();
+  getItems_params{}.write_url(url);
+  EXPECT_EQ("/items", url);
+
+  url.clear();
+  putVehicle_params{}.write_url(url);
+  EXPECT_EQ("/vehicles", url);
+
+  // to_url only appends query parameters.
+  auto const u = tag.to_url("/items/7/tags/b");
+  EXPECT_EQ(std::string_view::npos, u.buffer().find("id="));
+  EXPECT_EQ(std::string_view::npos, u.buffer().find("tag="));
+}
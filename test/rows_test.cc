@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+
+#include <optional>
+#include <type_traits>
+
+#include "boost/json.hpp"
+
+#include "openapi/json.h"
+#include "openapi/rows.h"
+
+#include "pet-api/pet-api.h"
+
+using namespace openapi;
+using namespace pet;
+
+TEST(rows, generated_types) {
+  static_assert(
+      std::is_same_v<decltype(Zone::polygon_), fixed_rows<double, 2U>>);
+  static_assert(std::is_same_v<decltype(Zone::blocks_),
+                               std::optional<ragged_rows<std::int64_t>>>);
+}
+
+TEST(rows, json) {
+  auto const s = R"({"polygon":[[8.65,49.87],[8.66,49.88],[8.64,49.89]],
+                     "blocks":[[1,2,3],[],[4]]})";
+  auto const zone = json::value_to<Zone>(json::parse(s));
+  ASSERT_EQ(3U, zone.polygon_.size());
+  EXPECT_EQ(8.66, zone.polygon_[1][0]);
+  EXPECT_EQ(49.89, zone.polygon_[2][1]);
+  ASSERT_TRUE(zone.blocks_.has_value());
+  ASSERT_EQ(3U, zone.blocks_->size());
+  EXPECT_EQ(3U, (*zone.blocks_)[0].size());
+  EXPECT_TRUE((*zone.blocks_)[1].empty());
+  EXPECT_EQ(4, (*zone.blocks_)[2][0]);
+
+  EXPECT_EQ(json::parse(s), json::value_from(zone));
+  EXPECT_EQ(json::serialize(json::value_from(zone)).size(),
+            serialized_size(zone));
+
+  EXPECT_ANY_THROW(
+      json::value_to<Zone>(json::parse(R"({"polygon":[[8.65,49.87,0]]})")));
+}
+
+TEST(rows, lazy) {
+  auto const s = R"({"polygon": [ [8.65, 49.87], [-8.66, 4.988e1] ],
+                     "blocks": [[1, 2, 3], [], [4]]})";
+  auto const lazy = ZoneLazy{s};
+  EXPECT_EQ(json::value_to<Zone>(json::parse(s)), lazy.get());
+
+  auto r = ragged_rows<std::int64_t>{};
+  parse_rows("[]", r);
+  EXPECT_TRUE(r.empty());
+
+  auto f = fixed_rows<double, 2U>{};
+  EXPECT_ANY_THROW(parse_rows("[[1,2],[3]]", f));
+  EXPECT_ANY_THROW(parse_rows("[[1,2],[3,x]]", f));
+  EXPECT_ANY_THROW(parse_rows("[[1,2]] ,", f));
+
+  f.push_back({1.0, 2.0});
+  EXPECT_ANY_THROW(parse_rows("[[1,2]", f));
+}
+
+TEST(rows, lazy_matches_dom) {
+  auto const dom = [](std::string_view s) {
+    try {
+      return std::optional{
+          json::value_to<ragged_rows<std::int64_t>>(json::parse(s))};
+    } catch (...) {
+      return std::optional<ragged_rows<std::int64_t>>{};
+    }
+  };
+  auto const lazy = [](std::string_view s) {
+    try {
+      auto r = ragged_rows<std::int64_t>{};
+      parse_rows(s, r);
+      return std::optional{r};
+    } catch (...) {
+      return std::optional<ragged_rows<std::int64_t>>{};
+    }
+  };
+
+  for (auto const s :
+       {"[[1,-2,0]]", "[[1.0,1e2,-3E+1]]", "[[1.5]]", "[[nan]]", "[[inf]]",
+        "[[-inf]]", "[[.5]]", "[[+1]]", "[[-]]", "[[1e400]]",
+        "[[9223372036854775807]]", "[[9223372036854775808]]"}) {
+    EXPECT_EQ(dom(s), lazy(s)) << s;
+  }
+  EXPECT_TRUE(lazy("[[1.0,1e2,-3E+1]]").has_value());
+  for (auto const s : {"[[nan]]", "[[01]]", "[[1.]]", "[[1e]]", "[[1e+]]"}) {
+    EXPECT_FALSE(lazy(s).has_value()) << s;
+  }
+
+  auto f = fixed_rows<double, 2U>{};
+  EXPECT_ANY_THROW(parse_rows("[[nan,1]]", f));
+  EXPECT_ANY_THROW(parse_rows("[[1,-inf]]", f));
+  EXPECT_NO_THROW(parse_rows("[[-0,1e-2]]", f));
+}
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <ranges>
+#include <string>
+#include <string_view>
+
+#include "boost/json.hpp"
+
+#include "openapi/stream.h"
+
+#include "pet-api/pet-api.h"
+
+namespace json = boost::json;
+using namespace pet;
+
+TEST(openapi, stream_array) {
+  auto const items = getItems_response{
+      Item{.x_ = StatusEnum::ON, .y_ = Pets{PetsEnum::A}, .z_ = 1},
+      Item{.x_ = StatusEnum::OFF, .y_ = Pets{}},
+      Item{.x_ = StatusEnum::ON, .y_ = Pets{PetsEnum::A, PetsEnum::B}}};
+
+  auto buf = std::array<char, 8U>{};
+  auto out = std::string{};
+  auto n_chunks = 0U;
+  auto sink = openapi::chunk_sink{buf, [&](std::string_view chunk) {
+                                    EXPECT_LE(chunk.size(), buf.size());
+                                    out.append(chunk);
+                                    ++n_chunks;
+                                  }};
+  stream_getItems_response(items, sink);
+
+  EXPECT_EQ(json::serialize(json::value_from(items)), out);
+  EXPECT_GT(n_chunks, 1U);
+}
+
+TEST(openapi, stream_generated_range) {
+  auto const make_item = [](int const i) {
+    return Item{.x_ = StatusEnum::ON, .y_ = Pets{}, .z_ = i};
+  };
+
+  auto buf = std::array<char, 16U>{};
+  auto out = std::string{};
+  auto sink = openapi::chunk_sink{
+      buf, [&](std::string_view chunk) { out.append(chunk); }};
+  stream_getItems_response(std::views::iota(0, 3) |
+                               std::views::transform(make_item),
+                           sink);
+
+  EXPECT_EQ(R"([{"x":"ON","y":[],"z":0},{"x":"ON","y":[],"z":1},)"
+            R"({"x":"ON","y":[],"z":2}])",
+            out);
+}
+
+TEST(openapi, stream_decoder) {
+  auto const items = getItems_response{
+      Item{.x_ = StatusEnum::ON, .y_ = Pets{PetsEnum::A}, .z_ = 1},
+      Item{.x_ = StatusEnum::OFF, .y_ = Pets{PetsEnum::B}}};
+  auto const json = json::serialize(json::value_from(items));
+
+  auto decoder = getItems_response_decoder{};
+  for (auto i = 0U; i < json.size(); i += 3U) {
+    decoder.feed(std::span{json}.subspan(i, std::min(3UL, json.size() - i)));
+  }
+  EXPECT_EQ(items, decoder.finish());
+
+  decoder.feed(std::span{json});
+  EXPECT_EQ(items, decoder.finish());
+}
+
+TEST(openapi, stream_decoder_recovers_from_errors) {
+  auto const valid = std::string_view{R"([{"x":"ON","y":["A"],"z":1}])"};
+  auto const expected = getItems_response{
+      Item{.x_ = StatusEnum::ON, .y_ = Pets{PetsEnum::A}, .z_ = 1}};
+
+  auto decoder = getItems_response_decoder{};
+
+  // Truncated document: finish() throws.
+  decoder.feed(std::span{valid.substr(0U, 10U)});
+  EXPECT_ANY_THROW(decoder.finish());
+  decoder.feed(std::span{valid});
+  EXPECT_EQ(expected, decoder.finish());
+
+  // Well-formed JSON that does not match the schema: value_to throws.
+  decoder.feed(std::span{std::string_view{R"([{"x":"DIM","y":[]}])"}});
+  EXPECT_ANY_THROW(decoder.finish());
+  decoder.feed(std::span{valid});
+  EXPECT_EQ(expected, decoder.finish());
+
+  // Syntax error: thrown by feed() or, at the latest, by finish().
+  EXPECT_ANY_THROW({
+    decoder.feed(std::span{std::string_view{"[}"}});
+    decoder.finish();
+  });
+  decoder.feed(std::span{valid});
+  EXPECT_EQ(expected, decoder.finish());
+}
@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <thread>
+
+#include "boost/json.hpp"
+
+#include "openapi/trace.h"
+
+#include "pet-api/pet-api.h"
+
+namespace json = boost::json;
+using namespace openapi;
+using namespace pet;
+
+TEST(trace, chrome_trace) {
+  trace::clear();
+
+  {
+    auto const s = trace::span{"handler"};
+    auto const vehicle = decode_putVehicle_request(R"({"id":"bus-1"})");
+    encode_putVehicle_response(vehicle);
+  }
+  std::thread{[]() { auto const s = trace::span{"worker"}; }}.join();
+
+  auto out = std::stringstream{};
+  trace::write_chrome_trace(out);
+  auto const events = json::parse(out.str()).at("traceEvents").as_array();
+
+  if constexpr (trace::kEnabled) {
+    ASSERT_EQ(4U, events.size());
+    EXPECT_EQ("putVehicle.body_decode", events[0].at("name").as_string());
+    EXPECT_EQ("putVehicle.response_encode", events[1].at("name").as_string());
+    EXPECT_EQ("handler", events[2].at("name").as_string());
+    EXPECT_EQ("worker", events[3].at("name").as_string());
+    EXPECT_EQ("X", events[2].at("ph").as_string());
+    EXPECT_NE(events[2].at("tid"), events[3].at("tid"));
+    EXPECT_LE(events[2].at("ts").to_number<double>(),
+              events[0].at("ts").to_number<double>());
+  } else {
+    EXPECT_TRUE(events.empty());
+  }
+}
+
+TEST(trace, exited_threads) {
+  trace::clear();
+
+  // Rings of exited threads are freed, only their spans are kept, and at
+  // most ring::kSize of them.
+  for (auto i = 0; i != 8; ++i) {
+    std::thread{[]() {
+      for (auto j = std::size_t{0U}; j != trace::ring::kSize / 4U; ++j) {
+        auto const s = trace::span{"worker"};
+      }
+    }}.join();
+  }
+
+  auto out = std::stringstream{};
+  trace::write_chrome_trace(out);
+  auto const events = json::parse(out.str()).at("traceEvents").as_array();
+
+  if constexpr (trace::kEnabled) {
+    ASSERT_EQ(trace::ring::kSize, events.size());
+    EXPECT_NE(events[0].at("tid"), events[events.size() - 1U].at("tid"));
+  } else {
+    EXPECT_TRUE(events.empty());
+  }
+}
@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "boost/json.hpp"
+#include "boost/url.hpp"
+
+#include "openapi/json.h"
+#include "openapi/parse.h"
+#include "openapi/uuid.h"
+
+#include "pet-api/pet-api.h"
+
+using namespace openapi;
+using namespace pet;
+
+namespace {
+
+uuid read(std::string_view s) {
+  auto u = uuid{};
+  parse(s, u);
+  return u;
+}
+
+}  // namespace
+
+TEST(uuid, generated_types) {
+  static_assert(std::is_same_v<decltype(Booking::id_), uuid>);
+  static_assert(std::is_same_v<decltype(Booking::related_),
+                               std::optional<std::vector<uuid>>>);
+  static_assert(std::is_same_v<decltype(getBooking_params::session_),
+                               std::optional<uuid>>);
+  static_assert(sizeof(uuid) == 16U);
+  static_assert(std::is_trivially_copyable_v<uuid>);
+}
+
+TEST(uuid, parse_format) {
+  auto const u = read("0189F7EA-ae05-7C3b-9d4e-00ff10203040");
+  EXPECT_EQ(0x01U, u.bytes_[0]);
+  EXPECT_EQ(0x89U, u.bytes_[1]);
+  EXPECT_EQ(0xFFU, u.bytes_[11]);
+  EXPECT_EQ(0x40U, u.bytes_[15]);
+
+  auto buf = uuid_buf_t{};
+  EXPECT_EQ("0189f7ea-ae05-7c3b-9d4e-00ff10203040", format(u, buf));
+
+  auto ss = std::stringstream{};
+  ss << uuid{};
+  EXPECT_EQ("00000000-0000-0000-0000-000000000000", ss.str());
+
+  EXPECT_ANY_THROW(read(""));
+  EXPECT_ANY_THROW(read("0189f7ea-ae05-7c3b-9d4e-00ff1020304"));
+  EXPECT_ANY_THROW(read("0189f7ea-ae05-7c3b-9d4e-00ff102030400"));
+  EXPECT_ANY_THROW(read("0189f7eaae057c3b9d4e00ff10203040"));
+  EXPECT_ANY_THROW(read("0189f7ea-ae05-7c3b-9d4e_00ff10203040"));
+  EXPECT_ANY_THROW(read("0189f7eg-ae05-7c3b-9d4e-00ff10203040"));
+}
+
+TEST(uuid, order_and_hash) {
+  auto const a = read("00000000-0000-0000-0000-0000000000ff");
+  auto const b = read("00000000-0000-0000-0000-000000000100");
+  auto const c = read("10000000-0000-0000-0000-000000000000");
+  EXPECT_LT(a, b);
+  EXPECT_LT(b, c);
+  EXPECT_EQ(a, read("00000000-0000-0000-0000-0000000000FF"));
+
+  auto const set = std::unordered_set<uuid>{a, b, c, a};
+  EXPECT_EQ(3U, set.size());
+  EXPECT_TRUE(set.contains(b));
+}
+
+TEST(uuid, json) {
+  auto const jv = json::parse(
+      R"({"id":"0189f7ea-ae05-7c3b-9d4e-00ff10203040",)"
+      R"("related":["00000000-0000-0000-0000-000000000001"]})");
+  auto const booking = json::value_to<Booking>(jv);
+  EXPECT_EQ(read("0189f7ea-ae05-7c3b-9d4e-00ff10203040"), booking.id_);
+  EXPECT_EQ(jv, json::value_from(booking));
+  EXPECT_EQ(json::serialize(jv).size(), serialized_size(booking));
+
+  EXPECT_ANY_THROW(json::value_to<Booking>(json::parse(R"({"id":"x"})")));
+}
+
+TEST(uuid, params) {
+  auto p = getBooking_params{};
+  p.id_ = read("0189f7ea-ae05-7c3b-9d4e-00ff10203040");
+  p.session_ = read("00000000-0000-0000-0000-000000000001");
+
+  auto url = std::string{};
+  p.write_url(url);
+  EXPECT_EQ(
+      "/bookings/0189f7ea-ae05-7c3b-9d4e-00ff10203040"
+      "?session=00000000-0000-0000-0000-000000000001",
+      url);
+
+  auto const parsed = boost::urls::url_view{url};
+  auto const m = match_route(http_method::kGet, parsed.encoded_path());
+  ASSERT_EQ(operation_id::getBooking, m.op_);
+  auto const roundtrip =
+      getBooking_params{parsed.params(), getBooking_path{m.path_params_[0]}};
+  EXPECT_EQ(p.id_, roundtrip.id_);
+  EXPECT_EQ(p.session_, roundtrip.session_);
+}